@@ -1401,6 +1401,10 @@
   #define HAS_FOLDER_SORTING (FOLDER_SORTING || ENABLED(SDSORT_GCODE))
 #endif
 
+#if ENABLED(SDSUPPORT) && !defined(SD_READ_BUFFER_SIZE)
+  #define SD_READ_BUFFER_SIZE 16
+#endif
+
 /**
  * MOV_AXIS: number of independent axes driving the tool head's translational movement
  * NUM_AXIS: number of movement axes + 1
@@ -579,7 +579,12 @@
 
 // Enable this feature if all enabled endstop pins are interrupt-capable.
 // This will remove the need to poll the interrupt pins, saving many CPU cycles.
-//#define ENDSTOP_INTERRUPTS_FEATURE
+// On the Arduino MEGA, endstop pins that can't raise an interrupt are still polled.
+#ifdef LGT_MAC
+	#define ENDSTOP_INTERRUPTS_FEATURE
+#else
+	//#define ENDSTOP_INTERRUPTS_FEATURE
+#endif
 
 /**
  * Endstop Noise Filter
@@ -973,6 +978,7 @@
   #define NUM_RUNOUT_SENSORS   1     // Number of sensors, up to one per extruder. Define a FIL_RUNOUT#_PIN for each.
   #define FIL_RUNOUT_INVERTING true // set to true to invert the logic of the sensor.
   #define FIL_RUNOUT_PULLUP          // Use internal pullup for filament runout pins.
+  #define FIL_RUNOUT_DEBOUNCE 100   // (ms) Time the sensor must read out before a runout is handled.
   #define FILAMENT_RUNOUT_SCRIPT  "M25"/*"M600 E2 Z0 X10 Y250 F600"*///"M25"//"M600"
 #endif
 
@@ -1047,6 +1053,9 @@
   // contours of the bed more closely than edge-to-edge straight moves.
   #define SEGMENT_LEVELED_MOVES
   #define LEVELED_SEGMENT_LENGTH 5.0 // (mm) Length of all segments (except the last one)
+  // With bilinear leveling, split only at grid lines and where the straight segment
+  // would stray from the mesh by more than this. Comment out for fixed-length segments.
+  #define LEVELED_SEGMENT_TOLERANCE 0.005 // (mm)
 
   /**
    * Enable the G26 Mesh Validation Pattern tool.
@@ -1086,6 +1095,10 @@
     // Default is to maintain the height of the nearest edge.
     //#define EXTRAPOLATE_BEYOND_GRID
 
+    // Precompute each grid cell as a + bu + cv + duv in microns after G29 / M420,
+    // so a leveling correction is a lookup and three multiply-adds. 8 bytes per cell.
+    #define BILINEAR_CELL_COEFFICIENTS
+
     //
     // Experimental Subdivision of the grid by Catmull-Rom method.
     // Synthesizes intermediate points to produce a more detailed mesh.
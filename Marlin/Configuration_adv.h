@@ -118,6 +118,15 @@
   #endif
 #endif
 
+#if ENABLED(PIDTEMP) || ENABLED(PIDTEMPBED)
+  // Run the PID loops in Q16.16 fixed point instead of software float, at a
+  // fraction of the cycles. The P, I and D terms are computed as in the float
+  // loop, except that the error, the integral and the D term are held where
+  // Q16.16 would overflow, past the point where the output saturates.
+  // Not yet validated on hardware. PID_EXTRUSION_SCALING is not supported.
+  //#define PID_FIXED_POINT
+#endif
+
 /**
  * Automatic Temperature:
  * The hotend target temperature is calculated by all the buffered lines of gcode.
@@ -389,6 +398,10 @@
 #define Y_HOME_BUMP_MM 5
 #define Z_HOME_BUMP_MM 2
 #define HOMING_BUMP_DIVISOR { 2, 2, 4 }  // Re-Bump Speed Divisor (Divides the Homing Feedrate)
+// With ENDSTOP_INTERRUPTS_FEATURE, an endstop or probe on an interrupt pin stops the axis on the
+// step that triggers it, not up to 1ms later. Multiply the first homing and double-probing
+// approach by this for those. The bump still sets the final position.
+#define HOMING_FAST_APPROACH 1.5
 //#define QUICK_HOME                     // If homing includes X and Y, do a diagonal move initially
 
 // When G28 is called, this option will make Y home before X
@@ -465,6 +478,43 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Step Interval Ramps
+ *
+ * The planner describes the acceleration and deceleration of each block as a ramp
+ * of step intervals that the stepper ISR follows with a few additions, instead of
+ * converting a new step rate with calc_timer_interval() on every step. Ramps cover
+ * the step rates where one ramp segment (a 2^(1/4) change of rate) takes at least
+ * STEP_RAMP_MIN_STEPS steps. Slower steps, where the ISR has time to spare, are
+ * timed as before. Uses 34 bytes of SRAM per planner block (544 bytes with a
+ * BLOCK_BUFFER_SIZE of 16), so check the free SRAM of your build before enabling.
+ * Not compatible with S_CURVE_ACCELERATION or ADAPTIVE_STEP_SMOOTHING.
+ */
+//#define STEP_INTERVAL_RAMPS
+#if ENABLED(STEP_INTERVAL_RAMPS)
+  #define STEP_RAMP_MIN_STEPS 32
+#endif
+
+/**
+ * Stepper ISR Governor
+ *
+ * The stepper ISR measures the share of each 16ms window it spends running.
+ * While that load is over STEP_GOVERNOR_LOAD_HIGH percent, the planner caps the
+ * step rate of new blocks to bring it back to STEP_GOVERNOR_LOAD_TARGET, so the
+ * printer slows down evenly instead of the ISR falling behind. The cap relaxes
+ * by 1/8 per window once the load drops under STEP_GOVERNOR_LOAD_LOW.
+ * M2015 reports the load, the ISR overruns and the number of governed blocks.
+ * Capped blocks print slower, extrusion included. The thresholds are untested
+ * on hardware, so check the load with M2015 before enabling.
+ */
+//#define STEP_ISR_GOVERNOR
+#if ENABLED(STEP_ISR_GOVERNOR)
+  #define STEP_GOVERNOR_LOAD_HIGH   85  // (%) Cap new blocks above this load
+  #define STEP_GOVERNOR_LOAD_TARGET 75  // (%) Load the cap aims for
+  #define STEP_GOVERNOR_LOAD_LOW    60  // (%) Relax the cap under this load
+  #define STEP_GOVERNOR_MIN_RATE  4000  // (steps/s) Never cap blocks below this rate
+#endif
+
 // Microstep setting (Only functional when stepper driver microstep pins are connected to MCU.
 #define MICROSTEP_MODES { 16, 16, 16, 16, 16 } // [1,2,4,8,16]
 
@@ -588,6 +638,18 @@
   // Add an option in the menu to run all auto#.g files
   //#define MENU_ADDAUTOSTART
 
+  // Bytes read from the file per SD access while printing. G-code lines are
+  // scanned out of this buffer instead of being fetched one character at a time.
+  // Must be a power of 2 up to 512. At 512 whole blocks bypass the volume cache.
+  // Costs its size in SRAM. Disabled, a 16 byte buffer is used.
+  //#define SD_READ_BUFFER_SIZE 512
+
+  // 512 byte block cache slots shared by file data, FAT and directory blocks (1-4).
+  // With 2 or more, FAT lookups at cluster boundaries and power-loss recovery file
+  // writes no longer evict each other. Each slot costs 512 bytes of SRAM, so
+  // check the free SRAM of your build before adding one. M2010 reports hits and misses.
+  #define SD_CACHE_SLOTS 1
+
   /**
    * Continue after Power-Loss (Creality3D)
    *
@@ -887,6 +949,8 @@
 // @section serial
 
 // The ASCII buffer for serial input
+// Commands are packed into BUFSIZE * MAX_CMD_SIZE bytes, so many more
+// than BUFSIZE short commands (e.g., typical G1 lines) can be queued.
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
@@ -905,6 +969,13 @@
 // :[0, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048]
 //#define RX_BUFFER_SIZE 1024
 
+#ifdef LGT_MAC
+  // DWIN touchscreen (serial_port1) transmit buffer. Sized to hold a full
+  // status refresh so frames are queued at once and drained by the UDRE ISR.
+  // :[32, 64, 128, 256]
+  #define TX_BUFFER_SIZE1 128
+#endif
+
 #if RX_BUFFER_SIZE >= 1024
   // Enable to have the controller send XON/XOFF control characters to
   // the host to signal the RX buffer is becoming full.
@@ -1453,6 +1524,33 @@
  */
 //#define PINS_DEBUGGING
 
+/**
+ * M2011 - Report how long each idle() task runs: a runtime histogram
+ * (<64us, <128us ... <4096us, longer), the longest run, and the number
+ * of runs over the task's budget. M2011 R resets the statistics.
+ * Costs 20 bytes of SRAM per idle task built in.
+ */
+//#define IDLE_TASK_STATS
+
+/**
+ * M2013 - Report motion benchmark counters: blocks planned, average and
+ * longest planning time per block, planner underruns with commands still
+ * queued, and the fastest step rate reached. M2013 R resets them.
+ * Underruns are only counted while a move (G0-G3, G5, G6) is the command
+ * in progress, so waits like G4, M109 or M400 don't count. The planner
+ * running dry inside other moving commands (G28, G29, T...) isn't counted.
+ */
+//#define MOTION_STATS
+
+/**
+ * M2014 - Report how long the Stepper, Temperature and serial RX ISRs,
+ * manage_heater() and LGT_Main_Function() take: count, shortest, mean and
+ * longest run, and a histogram (<8us, <32us ... <32ms, longer), timed
+ * with the step timer. M2014 R resets them. Adds about 12us to each ISR
+ * and 220 bytes of SRAM, so leave it off in production firmware.
+ */
+//#define CYCLE_PROFILER
+
 /**
  * Auto-report temperatures with M155 S<seconds>
  */
@@ -1498,7 +1596,8 @@
 #define PROPORTIONAL_FONT_RATIO 1.0
 
 /**
- * Spend 28 bytes of SRAM to optimize the GCode parser
+ * Spend 140 bytes of SRAM to optimize the GCode parser.
+ * Parameter values are decoded once per line instead of on every read.
  */
 #define FASTER_GCODE_PARSER
 
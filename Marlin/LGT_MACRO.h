@@ -11,8 +11,12 @@
 #define LED_BLUE 6
 #define DATA_SIZE 37    //the size of ScreenData and Receive_Cmd
 #define FILE_LIST_NUM  25
+#define FILE_PAGE_NUM  5     //file names per page of the file list
 
 #define EEPROM_INDEX 4000
+#define EEPROM_TIME_RING (EEPROM_INDEX + 8)    //total print time, wear-levelled over the end of the EEPROM
+#define EEPROM_TIME_SLOTS 17
+#define EEPROM_TIME_RING_FLAG 1               //at EEPROM_INDEX + 5 once the ring is set up
 
 //Printer kill reason
 #define E_TEMP_ERROR		"Error 0: abnormal E temp"   //Heating failed
@@ -41,6 +45,7 @@
 #define LEN_6_CHR 6
 
 #define TEMP_RANGE 2
+#define DW_TEMP_HYSTERESIS 1    // temperatures within +-1 of the shown value are not resent
 #define PLA_E_TEMP PREHEAT_1_TEMP_HOTEND  //200
 #define PLA_B_TEMP PREHEAT_1_TEMP_BED     //60
 #define ABS_E_TEMP PREHEAT_2_TEMP_HOTEND  //230
@@ -69,6 +74,10 @@
 #define DW_ADDR_CHANGE_PAGE 0x0084
 #define DW_PAGE_VAR_BASE 0x5A010000UL 
 
+// Burst writes may bridge this many words between two values, writing them as zero.
+// Only raise it for words the DGUS screen project is known not to use.
+#define DW_BURST_MAX_GAP 0
+
 // user defined variable address
 #define ADDR_USER_VAR_BASE                  (0x1000)
 #define ADDR_VAL_MENU_TYPE                   ADDR_USER_VAR_BASE                             // 1000
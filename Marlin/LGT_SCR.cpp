@@ -1,4 +1,5 @@
 #include "LGT_SCR.h"
+#include "cycle_profiler.h"
 #include <stdio.h>
 
 #ifdef LGT_MAC
@@ -13,8 +14,10 @@ unsigned char data_storage[DATA_SIZE];
 char total_time[7];         //Total print time for each model 
 uint32_t total_print_time = 0;
 char printer_work_time[31];  //Total work time of printers
-int gcode_id[FILE_LIST_NUM], sel_fileid =-1;
+uint16_t gcode_id[FILE_LIST_NUM];  //directory entry index of each listed file, see CardReader::index_gcode_files()
+int sel_fileid =-1;
 int gcode_num=0;
+int gcode_sent = 0;                //file names already on the screen
 millis_t recovery_time=0;
 uint8_t recovery_percent = 0;
 float level_z_height = 0.0;
@@ -33,7 +36,17 @@ bool xy_home = false;
 	bool xyz_home = false,z_home=false;
 #endif
 bool leveling_wait = false;
-int re_count = 0;
+// DWIN receive parser state, see LGT_Get_MYSERIAL1_Cmd()
+enum DW_RX_STATE : uint8_t { eRX_HEAD_0, eRX_HEAD_1, eRX_LEN, eRX_BODY };
+static DW_RX_STATE rx_state = eRX_HEAD_0;
+static uint8_t rx_len = 0;                  // bytes following the length byte
+static uint8_t re_count = 0;                // bytes of the body received so far
+static unsigned char rx_storage[DATA_SIZE]; // kept apart from data_storage (TX)
+// Screen action left running in the background, see LGT_Run_Screen_Job()
+enum SCREEN_JOB : uint8_t { eJOB_NONE, eJOB_FILAMENT, eJOB_STOP };
+static SCREEN_JOB screen_job = eJOB_NONE;
+static int job_fila_len = 0;                // eJOB_FILAMENT: length being moved
+static millis_t job_ms = 0;                 // eJOB_STOP: when to finish stopping
 E_MENU_TYPE menu_type= eMENU_IDLE;
 PRINTER_STATUS status_type= PRINTER_SETUP;
 PRINTER_KILL_STATUS kill_type = PRINTER_NORMAL;
@@ -51,15 +64,67 @@ unsigned int filament_len = 10;
 unsigned int filament_temp = 200;
 
 const float manual_feedrate_mm_m[] = MANUAL_FEEDRATE;
+
+/*************************************
+Screen variable cache: the last value written to each polled VP address.
+LGT_Send_Changed_Data() drops writes that are within the hysteresis of
+the shadow value; anything written by the screen itself invalidates it.
+**************************************/
+typedef struct
+{
+	uint16_t addr;
+	uint8_t hysteresis;
+}DW_CACHE_VP;
+static const DW_CACHE_VP cache_vp[] PROGMEM = {
+	{ ADDR_VAL_CUR_E,          DW_TEMP_HYSTERESIS },
+	{ ADDR_VAL_TAR_E,          0 },
+	{ ADDR_VAL_CUR_B,          DW_TEMP_HYSTERESIS },
+	{ ADDR_VAL_TAR_B,          0 },
+	{ ADDR_VAL_FAN,            0 },
+	{ ADDR_VAL_FEED,           0 },
+	{ ADDR_VAL_FLOW,           0 },
+	{ ADDR_VAL_CUR_FEED,       0 },
+	{ ADDR_VAL_MOVE_POS_X,     0 },
+	{ ADDR_VAL_MOVE_POS_Y,     0 },
+	{ ADDR_VAL_MOVE_POS_Z,     0 },
+	{ ADDR_VAL_MOVE_POS_E,     0 },
+	{ ADDR_TXT_HOME_ELAP_TIME, 0 },    // shadowed as elapsed minutes
+	{ ADDR_VAL_HOME_PROGRESS,  0 },
+	{ ADDR_VAL_HOME_Z_HEIGHT,  0 }
+};
+#define CACHE_VP_NUM COUNT(cache_vp)
+static_assert(CACHE_VP_NUM <= 16, "cache_valid has room for 16 VP addresses.");
+static int16_t cache_val[CACHE_VP_NUM];
+static uint16_t cache_valid = 0;    // one bit per cache_vp entry
+uint32_t cache_hit = 0, cache_miss = 0;
+
+static int8_t LGT_Cache_Index(uint16_t addr)
+{
+	for (uint8_t i = 0; i < CACHE_VP_NUM; i++)
+		if (pgm_read_word(&cache_vp[i].addr) == addr)
+			return i;
+	return -1;
+}
 	void LGT_Line_To_Current(AxisEnum axis) {
 	if (!planner.is_full())
 		planner.buffer_line_kinematic(current_position, MMM_TO_MMS(manual_feedrate_mm_m[(int8_t)axis]), active_extruder);
+	}
+	static_assert(EEPROM_TIME_RING + EEPROM_RING_SIZE(EEPROM_TIME_SLOTS, sizeof(uint32_t)) <= E2END + 1, "EEPROM_TIME_SLOTS runs past the end of the EEPROM.");
+	void LGT_Save_Total_Time()
+	{
+		eeprom_ring_write(EEPROM_TIME_RING, EEPROM_TIME_SLOTS, &total_print_time, sizeof(total_print_time));
+	}
+	uint32_t LGT_Load_Total_Time()
+	{
+		uint32_t t;
+		eeprom_ring_read(EEPROM_TIME_RING, EEPROM_TIME_SLOTS, &t, sizeof(t));
+		return t;
 	}
 	 void LGT_Printer_Total_Work_Time()
 	{
 		Duration_Time = (print_job_timer.duration()) + recovery_time;
 		total_print_time = Duration_Time.minute()+ total_print_time;
-		eeprom_write_dword((uint32_t*)EEPROM_INDEX, total_print_time);
+		LGT_Save_Total_Time();
 	}
 	inline void LGT_Total_Time_To_String(char* buf,uint32_t time)
 	{
@@ -113,7 +178,12 @@ void LGT_SCR::LGT_Change_Filament(int fila_len)
 		if (!planner.is_full())
 			planner.buffer_line_kinematic(current_position, 600, 0, current_position[E_AXIS]);
 	}
-	planner.synchronize();
+	// the dialog stays up until the move is done, see LGT_Run_Screen_Job()
+	job_fila_len = fila_len;
+	screen_job = eJOB_FILAMENT;
+}
+void LGT_SCR::LGT_Change_Filament_Done(int fila_len)
+{
 	if (menu_type == eMENU_UTILI_FILA)
 	{
 		LGT_Change_Page(ID_MENU_UTILI_FILA_0 + menu_fila_type_chk);
@@ -133,102 +203,81 @@ void LGT_SCR::LGT_Change_Filament(int fila_len)
 }
 void LGT_SCR::LGT_DW_Setup()
 {
-	if (eeprom_read_byte((const uint8_t*)(EEPROM_INDEX + 5)) != 0)
+	const uint8_t time_flag = eeprom_read_byte((const uint8_t*)(EEPROM_INDEX + 5));
+	if (time_flag != EEPROM_TIME_RING_FLAG)
 	{
-		eeprom_write_dword((uint32_t*)EEPROM_INDEX, 0);
-		eeprom_write_byte((uint8_t *)(EEPROM_INDEX + 5), 0);
+		//0: kept at EEPROM_INDEX by older firmware, move it into the ring. Otherwise a blank EEPROM.
+		total_print_time = time_flag ? 0 : eeprom_read_dword((const uint32_t*)EEPROM_INDEX);
+		eeprom_ring_format(EEPROM_TIME_RING, EEPROM_TIME_SLOTS, &total_print_time, sizeof(total_print_time));
+		eeprom_write_byte((uint8_t *)(EEPROM_INDEX + 5), EEPROM_TIME_RING_FLAG);
 	}
-	total_print_time = eeprom_read_dword((const uint32_t*)EEPROM_INDEX);
+	total_print_time = LGT_Load_Total_Time();
 
 	LGT_Send_Data_To_Screen1(ADDR_TXT_ABOUT_MODEL, MAC_MODEL);
 	LGT_Send_Data_To_Screen1(ADDR_TXT_ABOUT_SIZE, MAC_SIZE);
 	LGT_Send_Data_To_Screen1(ADDR_TXT_ABOUT_FW_BOARD, BOARD_FW_VER);
 }
-uint8_t led_times = 1, led_status=0;
-int led_counter = 0;
+// Status LED effect, see LGT_Set_LED_Effect()
+static uint8_t led_color = LED_GREEN;
+static LED_EFFECT led_effect = eLED_OFF;
+static uint16_t led_period = 0;
+static int16_t led_duty = -1;    // last duty written to led_color, -1 to force a write
+static bool led_hold = false;    // set by M2012, keeps the printer status from changing the effect
+// Rising half of the breathing curve, gamma 2.2 corrected
+static const uint8_t led_breath[64] PROGMEM = {
+	  0,   0,   0,   0,   1,   1,   1,   2,   3,   4,   4,   5,   7,   8,   9,  11,
+	 13,  14,  16,  18,  20,  23,  25,  28,  31,  33,  36,  40,  43,  46,  50,  54,
+	 57,  61,  66,  70,  74,  79,  84,  89,  94,  99, 105, 110, 116, 122, 128, 134,
+	140, 147, 153, 160, 167, 174, 182, 189, 197, 205, 213, 221, 229, 238, 246, 255
+};
 /*************************************
-FUNCTION:	The state of LED lamp
-LED:	Color of LED lamp;(LED_REDLED_GREENLED_BLUE)
+FUNCTION:	Select the effect of the LED lamp
+LED:	Color of LED lamp;(LED_RED/LED_GREEN/LED_BLUE)
+period:	Breathing period in ms
+hold:	Keep the effect until LGT_Release_LED_Effect()
+The PWM outputs are only written when the effect or duty changes.
 **************************************/
-void LGT_SCR::LED_Bright_State(uint8_t LED, uint16_t per, uint8_t mod)
+void LGT_SCR::LGT_Set_LED_Effect(uint8_t LED, LED_EFFECT effect, uint16_t period, bool hold)
+{
+	if (led_hold && !hold)
+		return;
+	led_hold = hold;
+	period = constrain(period, 510, 51000);
+	if (LED == led_color && effect == led_effect && period == led_period)
+		return;
+	led_color = LED;
+	led_effect = effect;
+	led_period = period;
+	led_duty = -1;
+	analogWrite(LED_RED, 0);
+	analogWrite(LED_GREEN, 0);
+	analogWrite(LED_BLUE, 0);
+	LGT_LED_Effect_Update();
+}
+void LGT_SCR::LGT_Release_LED_Effect()
 {
-	if (mod == 0)  //LED lights are not lighted
+	led_hold = false;
+}
+/*************************************
+FUNCTION:	Step the LED effect. The breathing duty follows millis(),
+			so its rate doesn't depend on how often this is called
+**************************************/
+void LGT_SCR::LGT_LED_Effect_Update()
+{
+	uint8_t duty = 0;
+	if (led_effect == eLED_SOLID)
 	{
-		analogWrite(LED_RED, 0);
-		analogWrite(LED_GREEN, 0);
-		analogWrite(LED_BLUE, 0);
+		duty = 255;
 	}
-	else if (mod == 1)    //Breathing lamp
+	else if (led_effect == eLED_BREATHE)
 	{
-		if (per > 51000) per = 51000;
-		if (per < 510) per = 510;
-		uint8_t	led_multiple = ceil(per / 510.0);
-		if (led_times < led_multiple)
-		{
-			led_times++;
-		}
-		else
-		{
-			if (led_status == 0)
-			{
-				if (led_counter >100)
-				{
-					led_counter += 2;
-				}
-				else
-					led_counter++;
-				led_times = 1;
-				if (led_counter >= 254)
-					led_status = 1;
-			}
-			else
-			{
-				led_counter--;
-				led_times = 1;
-				if (led_counter <= 2)
-					led_status = 0;
-
-			}
-		}
-		if (LED == LED_RED)
-		{
-			analogWrite(LED_GREEN, 0);
-			analogWrite(LED_BLUE, 0);
-			analogWrite(LED, led_counter);
-		}
-		else if (LED == LED_GREEN)
-		{
-			analogWrite(LED_RED, 0);
-			analogWrite(LED_BLUE, 0);
-			analogWrite(LED, led_counter);
-		}
-		else if (LED == LED_BLUE)
-		{
-			analogWrite(LED_RED, 0);
-			analogWrite(LED_GREEN, 0);
-			analogWrite(LED, led_counter);
-		}
+		const uint8_t step = (millis() % led_period) * 128UL / led_period;
+		duty = pgm_read_byte(&led_breath[step < 64 ? step : 127 - step]);
 	}
-	else if (mod == 2)  //Bright
+	if (duty != led_duty)
 	{
-		if (LED == LED_RED)
-		{
-			analogWrite(LED_GREEN, 0);
-			analogWrite(LED_BLUE, 0);
-			analogWrite(LED, 255);
-		}
-		else if (LED == LED_GREEN)
-		{
-			analogWrite(LED_RED, 0);
-			analogWrite(LED_BLUE, 0);
-			analogWrite(LED, 255);
-		}
-		else if (LED == LED_BLUE)
-		{
-			analogWrite(LED_RED, 0);
-			analogWrite(LED_GREEN, 0);
-			analogWrite(LED, 255);
-		}
+		led_duty = duty;
+		analogWrite(led_color, duty);
 	}
 }
 void LGT_SCR::LGT_Printer_Status_Light()
@@ -236,22 +285,22 @@ void LGT_SCR::LGT_Printer_Status_Light()
 		switch (status_type)
 		{
 		case PRINTER_SETUP:
-			LED_Bright_State(LED_GREEN, 30000, 1);
+			LGT_Set_LED_Effect(LED_GREEN, eLED_BREATHE, 30000);
 			break;
 		case PRINTER_STANDBY:
-			LED_Bright_State(LED_GREEN, 30000, 1);
+			LGT_Set_LED_Effect(LED_GREEN, eLED_BREATHE, 30000);
 			break;
 		case PRINTER_HEAT:
-			LED_Bright_State(LED_RED, 1000, 2);
+			LGT_Set_LED_Effect(LED_RED, eLED_SOLID, 1000);
 			break;
 		case PRINTER_PRINTING:
-			LED_Bright_State(LED_BLUE, 1000, 2);
+			LGT_Set_LED_Effect(LED_BLUE, eLED_SOLID, 1000);
 			break;
 		case PRINTER_PAUSE:
-			LED_Bright_State(LED_RED, 1000, 2);
+			LGT_Set_LED_Effect(LED_RED, eLED_SOLID, 1000);
 			break;
 		case PRINTER_PRINTING_F:
-			LED_Bright_State(LED_GREEN, 1000, 2);
+			LGT_Set_LED_Effect(LED_GREEN, eLED_SOLID, 1000);
 			break;
 		default:
 			 status_type = PRINTER_STANDBY;
@@ -261,21 +310,75 @@ void LGT_SCR::LGT_Printer_Status_Light()
 
 void LGT_SCR::LGT_Change_Page(unsigned int pageid)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = DW_FH_0;
-	data_storage[1] = DW_FH_1;
-	data_storage[2] = 0x07;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = 0x00;
-	data_storage[5] = 0x84;
 	data_storage[6] = 0x5A;
 	data_storage[7] = 0x01;
 	data_storage[8] = (unsigned char)(pageid >> 8) & 0xFF;
 	data_storage[9] = (unsigned char)(pageid & 0x00FF);
-	for (int i = 0; i < 10; i++)
-		MYSERIAL1.print(data_storage[i]);
+	LGT_Send_VAR_Frame(DW_ADDR_CHANGE_PAGE, 4);
+}
+/*************************************
+FUNCTION:	Queueing a VAR_W frame to DWIN_Screen in one call
+frame:	buffer holding the payload from frame[6..]
+addr:	VP address
+len:	payload length
+**************************************/
+static void DW_Write_VAR_Frame(unsigned char* frame, uint16_t addr, uint8_t len)
+{
+	frame[0] = DW_FH_0;
+	frame[1] = DW_FH_1;
+	frame[2] = len + 3;    // cmd + addr + payload
+	frame[3] = DW_CMD_VAR_W;
+	frame[4] = (unsigned char)(addr >> 8);
+	frame[5] = (unsigned char)(addr & 0x00FF);
+	MYSERIAL1.write(frame, 6 + len);
+}
+void LGT_SCR::LGT_Send_VAR_Frame(uint16_t addr, uint8_t len)
+{
+	DW_Write_VAR_Frame(data_storage, addr, len);
 }
 
+/*************************************
+Burst writes: values queued for ascending VP addresses are collected in
+one VAR_W frame, with up to DW_BURST_MAX_GAP words between them written
+as zero. LGT_Burst_Flush() sends what has been collected.
+burst_storage is kept apart from data_storage, so direct writes made
+while a burst is being built don't disturb it.
+**************************************/
+static unsigned char burst_storage[DATA_SIZE];
+static uint16_t burst_addr = 0;     // VP address of the first word
+static uint8_t burst_len = 0;       // payload bytes collected
+#define BURST_MAX_LEN ((DATA_SIZE - 6) & ~1)
+
+void LGT_SCR::LGT_Burst_Add(uint16_t addr, const unsigned char* buf, uint8_t len)
+{
+	if (burst_len)
+	{
+		const uint16_t next = burst_addr + burst_len / 2;
+		if (addr < next || addr - next > DW_BURST_MAX_GAP
+			|| burst_len + (addr - next) * 2 + len > BURST_MAX_LEN)
+			LGT_Burst_Flush();
+		else
+			while (burst_len < (addr - burst_addr) * 2)
+				burst_storage[6 + burst_len++] = 0;
+	}
+	if (!burst_len)
+		burst_addr = addr;
+	memcpy(burst_storage + 6 + burst_len, buf, len);
+	burst_len += len;
+}
+void LGT_SCR::LGT_Burst_Add(uint16_t Addr, int16_t Num)
+{
+	const unsigned char word[LEN_WORD] = { (unsigned char)(Num >> 8), (unsigned char)(Num & 0x00FF) };
+	LGT_Cache_Store(Addr, Num);
+	LGT_Burst_Add(Addr, word, LEN_WORD);
+}
+void LGT_SCR::LGT_Burst_Flush()
+{
+	if (!burst_len)
+		return;
+	DW_Write_VAR_Frame(burst_storage, burst_addr, burst_len);
+	burst_len = 0;
+}
 
 /*************************************
 FUNCTION:	Checking sdcard and updating file list on screen
@@ -331,7 +434,7 @@ void LGT_SCR::LGT_SDCard_Status_Update()
 			DEHILIGHT_FILE_NAME();
 			sel_fileid = -1;
 			uint16_t var_addr = ADDR_TXT_PRINT_FILE_ITEM_0;
-			for (int i = 0; i < gcode_num; i++)   //Cleaning filename
+			for (int i = 0; i < gcode_sent; i++)   //Cleaning filename
 			{
 				LGT_Clean_DW_Display_Data(var_addr);
 				var_addr = var_addr+LEN_FILE_NAME;
@@ -340,7 +443,7 @@ void LGT_SCR::LGT_SDCard_Status_Update()
 			}
 			LGT_Clean_DW_Display_Data(ADDR_TXT_PRINT_FILE_SELECT);
 			card.release();
-			gcode_num = 0;
+			gcode_num = gcode_sent = 0;
 		}
 		sd_init_flag = true;
 	}
@@ -349,62 +452,39 @@ void LGT_SCR::LGT_SDCard_Status_Update()
 
 void LGT_SCR::LGT_Clean_DW_Display_Data(unsigned int addr)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = DW_FH_0;
-	data_storage[1] = DW_FH_1;
-	data_storage[2] = 0x05;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = (addr & 0xFF00) >> 8;
-	data_storage[5] = addr;
+	LGT_Cache_Invalidate(addr);
 	data_storage[6] = 0xFF;
 	data_storage[7] = 0xFF;
-	for (int i = 0; i < 8; i++)
-		MYSERIAL1.print(data_storage[i]);
+	LGT_Send_VAR_Frame(addr, 2);
 }
+/*************************************
+FUNCTION:	Indexing the G-code files in one pass over the directory,
+			names are then sent page by page by LGT_Send_Filename_Page()
+**************************************/
 void LGT_SCR::LGT_Display_Filename()
 {
-	gcode_num = 0;
-	uint16_t var_addr = ADDR_TXT_PRINT_FILE_ITEM_0;
-    const uint16_t FileCnt = card.get_num_Files();  //FileCnt:Total number of files
-	for (int i = (FileCnt - 1); i >= 0; i--)     //Reverse order
-	//for (int i=0;i<FileCnt;i++)                
-	{
-		card.getfilename(i);
-		if (!card.filenameIsDir)
-		{
-			gcode_id[gcode_num] = i;
-			gcode_num++;
-			LGT_MAC_Send_Filename(var_addr, i);
-			var_addr = var_addr + LEN_FILE_NAME;
-			if (gcode_num == 10|| gcode_num==20)
-				idle();
-			if (gcode_num >= FILE_LIST_NUM)
-				break;
-		}
-	}	
+	gcode_num = card.index_gcode_files(gcode_id, FILE_LIST_NUM);
+	gcode_sent = 0;
+	LGT_Send_Filename_Page();   // the first page right away
+}
+/*************************************
+FUNCTION:	Sending the next page of file names to DWIN_Screen,
+			called from the main function until the list is complete
+**************************************/
+void LGT_SCR::LGT_Send_Filename_Page()
+{
+	for (uint8_t i = 0; i < FILE_PAGE_NUM && gcode_sent < gcode_num; i++, gcode_sent++)
+		LGT_MAC_Send_Filename(ADDR_TXT_PRINT_FILE_ITEM_0 + gcode_sent * LEN_FILE_NAME, gcode_id[gcode_sent]);
 }
 /*************************************
 FUNCTION:	Printing SD card files to DWIN_Screen
 **************************************/
 void LGT_SCR::LGT_MAC_Send_Filename(uint16_t Addr, uint16_t Serial_Num)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = DW_FH_0;
-	data_storage[1] = DW_FH_1;
-	data_storage[2] = 0x22;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = (Addr & 0xFF00) >> 8;
-	data_storage[5] = Addr;
-	card.getfilename(Serial_Num);
-	for (int i = 0; i < 27; i++)
-	{
-		data_storage[6 + i] = card.longFilename[i];
-	}
-	for (int i = 0; i <37; i++)
-	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
-	}
+	card.getfilename_at(Serial_Num);
+	memset(data_storage + 6, 0, LEN_FILE_NAME - 1);
+	strncpy((char*)data_storage + 6, card.longFilename, 27);
+	LGT_Send_VAR_Frame(Addr, LEN_FILE_NAME - 1);
 }
 void LGT_SCR::LGT_Print_Cause_Of_Kill()
 {
@@ -455,53 +535,62 @@ void LGT_SCR::LGT_Print_Cause_Of_Kill()
 }
 /*************************************
 FUNCTION:	Getting and saving commands of MYSERIAL1(DWIN_Screen)
+	Frame: 5A A5 | LEN | CMD ADDR_H ADDR_L DATALEN DATA...
+	Bytes are consumed as they arrive and never waited for; a partial
+	frame is kept across calls and the parser resyncs on the header.
 **************************************/
 void LGT_SCR::LGT_Get_MYSERIAL1_Cmd()
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	while (re_count<DATA_SIZE &&MYSERIAL1.available() > 0)
+	while (MYSERIAL1.available() > 0)
 	{
-		data_storage[re_count] = MYSERIAL1.read();
-		if (data_storage[0] != DW_FH_0)
+		const unsigned char c = MYSERIAL1.read();
+		switch (rx_state)
 		{
-			continue;
-		}
-		delay(5);
-		re_count++;
-	}
-	if (re_count < 1)    //null
-		return;
-	else if (re_count >= 2 && (Rec_Data.head[0] == data_storage[0]) && (Rec_Data.head[1] == data_storage[1]))
-	{
-		Rec_Data.cmd = data_storage[3];
-		if (Rec_Data.cmd == DW_CMD_VAR_R)
-		{
-			Rec_Data.addr = data_storage[4];
-			Rec_Data.addr = (Rec_Data.addr << 8) | data_storage[5];
-			Rec_Data.datalen = data_storage[6];
-			for (int i = 0; i < Rec_Data.datalen; i = i + 2)
+		case eRX_HEAD_0:
+			if (c == DW_FH_0)
+				rx_state = eRX_HEAD_1;
+			break;
+		case eRX_HEAD_1:
+			if (c == DW_FH_1)
+				rx_state = eRX_LEN;
+			else if (c != DW_FH_0)   // 5A 5A A5 is still a valid start
+				rx_state = eRX_HEAD_0;
+			break;
+		case eRX_LEN:
+			if (c < 4 || c > DATA_SIZE - 3)   // cmd + addr + datalen at least
 			{
-				Rec_Data.data[i / 2] = data_storage[7 + i];
-				Rec_Data.data[i / 2] = (Rec_Data.data[i / 2] << 8) | data_storage[8 + i];
+				rx_state = (c == DW_FH_0) ? eRX_HEAD_1 : eRX_HEAD_0;
+				break;
 			}
-			LGT_Analysis_DWIN_Screen_Cmd();
-			re_count = 0;
-			memset(data_storage, 0, sizeof(data_storage));
-			memset(&Rec_Data,0,sizeof(Rec_Data));
-			Rec_Data.head[0] = DW_FH_0;
-			Rec_Data.head[1] = DW_FH_1;
-		}
-		else
-		{
+			rx_len = c;
 			re_count = 0;
-			memset(data_storage, 0, sizeof(data_storage));
+			rx_state = eRX_BODY;
+			break;
+		case eRX_BODY:
+			rx_storage[re_count++] = c;
+			if (re_count >= rx_len)
+			{
+				rx_state = eRX_HEAD_0;
+				if (rx_storage[0] == DW_CMD_VAR_R)
+				{
+					memset(&Rec_Data, 0, sizeof(Rec_Data));
+					Rec_Data.head[0] = DW_FH_0;
+					Rec_Data.head[1] = DW_FH_1;
+					Rec_Data.cmd = rx_storage[0];
+					Rec_Data.addr = rx_storage[1];
+					Rec_Data.addr = (Rec_Data.addr << 8) | rx_storage[2];
+					Rec_Data.datalen = rx_storage[3];
+					// datalen counts words, only take what the frame really carries
+					const uint8_t words = min((uint8_t)((rx_len - 4) / 2), (uint8_t)COUNT(Rec_Data.data));
+					NOMORE(Rec_Data.datalen, words);
+					for (uint8_t i = 0; i < Rec_Data.datalen; i++)
+						Rec_Data.data[i] = ((unsigned int)rx_storage[4 + 2 * i] << 8) | rx_storage[5 + 2 * i];
+					LGT_Analysis_DWIN_Screen_Cmd();
+				}
+			}
+			break;
 		}
 	}
-	else
-	{
-		re_count = 0;
-		memset(data_storage, 0, sizeof(data_storage));
-	}
 }
 void LGT_SCR::LGT_Stop_Printing()
 {
@@ -512,7 +601,12 @@ void LGT_SCR::LGT_Stop_Printing()
 		);
 		clear_command_queue();
 		quickstop_stepper();
-		delay(100);
+		// the rest runs from LGT_Run_Screen_Job() once the steppers have settled
+		job_ms = millis() + 100;
+		screen_job = eJOB_STOP;
+}
+void LGT_SCR::LGT_Stop_Printing_Done()
+{
 		print_job_timer.stop();
 		thermalManager.disable_all_heaters();
 	#if FAN_COUNT > 0
@@ -564,6 +658,7 @@ FUNCTION:	Analysising the commands of DWIN_Screen
 void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 {
 	uint16_t LGT_feedrate = 0;
+	LGT_Cache_Invalidate(Rec_Data.addr);   // the screen has changed it itself
 	switch (Rec_Data.addr)
 	{
 	case ADDR_VAL_PRINT_FILE_SELECT:   //Selecting gocede file and displaying on screen
@@ -588,7 +683,7 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 		filament_temp = Rec_Data.data[0];
 		break;	
 	case ADDR_TXT_ABOUT_MAC_TIME:
-		total_print_time = eeprom_read_dword((const uint32_t*)EEPROM_INDEX);
+		total_print_time = LGT_Load_Total_Time();
 		LGT_Total_Time_To_String(printer_work_time, total_print_time);
 		LGT_Send_Data_To_Screen1(ADDR_TXT_ABOUT_WORK_TIME_MAC, printer_work_time);
 		break;
@@ -973,7 +1068,7 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 		case eBT_PRINT_FILE_OPEN_YES:
 			if (sel_fileid > -1)
 			{
-					card.getfilename(gcode_id[sel_fileid]);
+					card.getfilename_at(gcode_id[sel_fileid]);
 					card.openFile(card.filename,true);
 					card.startFileprint();
 					print_job_timer.start();		
@@ -1035,7 +1130,6 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 			status_type = PRINTER_HEAT;
 			thermalManager.setTargetBed(PLA_B_TEMP);
 			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_E, thermalManager.target_temperature[0]);
-			delayMicroseconds(1);
 			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_B, thermalManager.target_temperature_bed);
 			LGT_Send_Data_To_Screen(ADDR_VAL_FILA_CHANGE_TEMP, thermalManager.target_temperature[0]);
 			break;
@@ -1046,7 +1140,6 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 			status_type = PRINTER_HEAT;
 			thermalManager.setTargetBed(ABS_B_TEMP);
 			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_E, thermalManager.target_temperature[0]);
-			delayMicroseconds(1);
 			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_B, thermalManager.target_temperature_bed);
 			LGT_Send_Data_To_Screen(ADDR_VAL_FILA_CHANGE_TEMP, thermalManager.target_temperature[0]);
 			break;
@@ -1153,7 +1246,7 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 			break;
 		case eBT_HOME_RECOVERY_NO:
 			total_print_time = total_print_time+job_recovery_info.print_job_elapsed/60;
-			eeprom_write_dword((uint32_t*)EEPROM_INDEX, total_print_time);
+			LGT_Save_Total_Time();
 
 			#if ENABLED(POWER_LOSS_RECOVERY)
 				card.removeJobRecoveryFile();
@@ -1375,7 +1468,8 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 			led_on = !led_on;
 			if (led_on == false)
 			{
-				LED_Bright_State(LED_BLUE, 10, 0);  //close LED
+				LGT_Release_LED_Effect();
+				LGT_Set_LED_Effect(LED_BLUE, eLED_OFF, 0);  //close LED
 				LGT_Send_Data_To_Screen(ADDR_VAL_LEDS_SWITCH, 1);
 				delay(5);
 			}
@@ -1417,109 +1511,152 @@ void LGT_SCR::LGT_Analysis_DWIN_Screen_Cmd()
 		break;
 	}
 }
-void LGT_SCR::LGT_Send_Data_To_Screen(uint16_t Addr, int16_t Num)
+/*************************************
+FUNCTION:	Queueing a VP value in the burst only if it differs from what
+			the screen shows; the caller sends it with LGT_Burst_Flush()
+**************************************/
+void LGT_SCR::LGT_Send_Changed_Data(uint16_t Addr, int16_t Num)
 {
-	    memset(data_storage, 0, sizeof(data_storage));
-		data_storage[0] = Send_Data.head[0];
-		data_storage[1] = Send_Data.head[1];
-		data_storage[2] = 0x05;
-		data_storage[3] = DW_CMD_VAR_W;
-		data_storage[4] = (unsigned char)(Addr>> 8); //(Num >> 8) & 0xFF
-		data_storage[5] = (unsigned char)(Addr & 0x00FF);
-		data_storage[6] = (unsigned char)(Num >> 8);
-		data_storage[7] = (unsigned char)(Num & 0x00FF);
-		for (int i = 0; i < 8; i++)
-		{
-			MYSERIAL1.print(data_storage[i]);
-			delayMicroseconds(1);
-		}
+	if (LGT_Cache_Check(Addr, Num))
+		LGT_Burst_Add(Addr, Num);
 }
-void LGT_SCR::LGT_Send_Data_To_Screen(unsigned int addr, float num, char axis)
+/*************************************
+FUNCTION:	Queueing current and target temperatures (ADDR_VAL_CUR_E..TAR_B)
+			in the burst, all of them if forced or else only those changed
+**************************************/
+void LGT_SCR::LGT_Send_Temperatures(bool force)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	memset(Send_Data.data_num, 0, 6);
-	dtostrf((double)num, 2, 1, Send_Data.data_num);
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x09;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = (unsigned char)(addr >> 8);
-	data_storage[5] = (unsigned char)(addr & 0x00FF);
-	for (int i = 0; i < 6; i++)
+	const int16_t cur_e = (int16_t)thermalManager.current_temperature[0],
+	              tar_e = thermalManager.target_temperature[0],
+	              cur_b = (int16_t)thermalManager.current_temperature_bed,
+	              tar_b = thermalManager.target_temperature_bed;
+	if (force)
 	{
-		data_storage[6 + i] = Send_Data.data_num[i];
+		LGT_Burst_Add(ADDR_VAL_CUR_E, cur_e);
+		LGT_Burst_Add(ADDR_VAL_TAR_E, tar_e);
+		LGT_Burst_Add(ADDR_VAL_CUR_B, cur_b);
+		LGT_Burst_Add(ADDR_VAL_TAR_B, tar_b);
 	}
-	for (int i = 0; i < 12; i++)
+	else
 	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
+		LGT_Send_Changed_Data(ADDR_VAL_CUR_E, cur_e);
+		LGT_Send_Changed_Data(ADDR_VAL_TAR_E, tar_e);
+		LGT_Send_Changed_Data(ADDR_VAL_CUR_B, cur_b);
+		LGT_Send_Changed_Data(ADDR_VAL_TAR_B, tar_b);
 	}
 }
-
-void LGT_SCR::LGT_Send_Data_To_Screen(unsigned int addr, char* buf)
+/*************************************
+FUNCTION:	Checking a value against the screen variable cache
+return:	true if the value has to be sent, it is then counted as a miss
+**************************************/
+bool LGT_SCR::LGT_Cache_Check(uint16_t Addr, int16_t Num)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x0A;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = (unsigned char)(addr >> 8);
-	data_storage[5] = (unsigned char)(addr & 0x00FF);
-	for (int i = 0; i < 7; i++)
-	{
-		data_storage[6 + i] = buf[i];
-	}
-	for (int i = 0; i < 13; i++)
-
+	const int8_t i = LGT_Cache_Index(Addr);
+	if (i >= 0 && TEST(cache_valid, i))
 	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
+		const int16_t hysteresis = pgm_read_byte(&cache_vp[i].hysteresis);
+		if (Num >= cache_val[i] - hysteresis && Num <= cache_val[i] + hysteresis)
+		{
+			cache_hit++;
+			return false;
+		}
 	}
+	cache_miss++;
+	return true;
 }
-void LGT_SCR::LGT_Send_Data_To_Screen1(unsigned int addr,const char* buf)
+void LGT_SCR::LGT_Cache_Store(uint16_t Addr, int16_t Num)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x22;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = (unsigned char)(addr >> 8);
-	data_storage[5] = (unsigned char)(addr & 0x00FF);
-	for (int i = 0; i < 31; i++)
+	const int8_t i = LGT_Cache_Index(Addr);
+	if (i >= 0)
 	{
-		data_storage[6 + i] = buf[i];
+		cache_val[i] = Num;
+		SBI(cache_valid, i);
 	}
-	for (int i = 0; i < 37; i++)
+}
+void LGT_SCR::LGT_Cache_Invalidate(uint16_t Addr)
+{
+	const int8_t i = LGT_Cache_Index(Addr);
+	if (i >= 0)
+		CBI(cache_valid, i);
+}
+void LGT_SCR::LGT_Cache_Clear()
+{
+	cache_valid = 0;
+}
+void LGT_SCR::LGT_Cache_Report(bool reset)
+{
+	SERIAL_ECHO_START();
+	SERIAL_ECHOPAIR("DWIN cache hits: ", cache_hit);
+	SERIAL_ECHOLNPAIR(" misses: ", cache_miss);
+	if (reset)
+		cache_hit = cache_miss = 0;
+}
+void LGT_SCR::LGT_Send_Data_To_Screen(uint16_t Addr, int16_t Num)
+{
+	LGT_Cache_Store(Addr, Num);
+	data_storage[6] = (unsigned char)(Num >> 8);
+	data_storage[7] = (unsigned char)(Num & 0x00FF);
+	LGT_Send_VAR_Frame(Addr, 2);
+}
+void LGT_SCR::LGT_Send_Data_To_Screen(unsigned int addr, float num, char axis)
+{
+	memset(Send_Data.data_num, 0, 6);
+	dtostrf((double)num, 2, 1, Send_Data.data_num);
+	memcpy(data_storage + 6, Send_Data.data_num, 6);
+	LGT_Send_VAR_Frame(addr, 6);
+}
 
-	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
-	}
+void LGT_SCR::LGT_Send_Data_To_Screen(unsigned int addr, char* buf)
+{
+	memcpy(data_storage + 6, buf, 7);
+	LGT_Send_VAR_Frame(addr, 7);
+}
+void LGT_SCR::LGT_Send_Data_To_Screen1(unsigned int addr,const char* buf)
+{
+	memset(data_storage + 6, 0, LEN_FILE_NAME - 1);
+	strncpy((char*)data_storage + 6, buf, LEN_FILE_NAME - 1);
+	LGT_Send_VAR_Frame(addr, LEN_FILE_NAME - 1);
 }
 
 void LGT_SCR::LGT_Screen_System_Reset()
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x07;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = 0x00;
-	data_storage[5] = 0x04;
 	data_storage[6] = 0x55;
 	data_storage[7] = 0xAA;
 	data_storage[8] = 0x5A;
 	data_storage[9] = 0xA5;
-	for (int i = 0; i < 10; i++)
+	LGT_Send_VAR_Frame(0x0004, 4);
+	LGT_Cache_Clear();
+}
+millis_t Next_Temp_Time = 0;
+/*************************************
+FUNCTION:	Finish a screen action once what it waits for is done,
+			so the main loop never stalls on a screen button
+**************************************/
+void LGT_SCR::LGT_Run_Screen_Job()
+{
+	switch (screen_job)
 	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
+	case eJOB_FILAMENT:
+		if (planner.has_blocks_queued())
+			return;
+		screen_job = eJOB_NONE;
+		LGT_Change_Filament_Done(job_fila_len);
+		break;
+	case eJOB_STOP:
+		if (PENDING(millis(), job_ms))
+			return;
+		screen_job = eJOB_NONE;
+		LGT_Stop_Printing_Done();
+		break;
+	default:
+		break;
 	}
 }
-millis_t Next_Temp_Time = 0;
 void LGT_SCR::LGT_Main_Function()
 {
+	PROFILE_SCOPE(LGT_MAIN);
 	LGT_Get_MYSERIAL1_Cmd();
+	LGT_Run_Screen_Job();
 	if (millis() >= Next_Temp_Time)
 	{
 		Next_Temp_Time += 2000;
@@ -1528,8 +1665,8 @@ void LGT_SCR::LGT_Main_Function()
 			tartemp_flag = false;
 			if(LGT_is_printing==false)
 				status_type = PRINTER_HEAT;
-			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_E, thermalManager.target_temperature[0]);
-			LGT_Send_Data_To_Screen(ADDR_VAL_TAR_B, thermalManager.target_temperature_bed);
+			LGT_Send_Temperatures(true);
+			LGT_Burst_Flush();
 		}
 		LGT_Printer_Data_Updata();
 		LGT_Get_MYSERIAL1_Cmd();
@@ -1539,73 +1676,74 @@ void LGT_SCR::LGT_Main_Function()
 			LGT_Printer_Light_Update();
 	#endif // U20_Pro
 	LGT_SDCard_Status_Update();
+	if (gcode_sent < gcode_num)
+		LGT_Send_Filename_Page();
 }
 void LGT_SCR::LGT_Printer_Data_Updata()
 {
 	uint8_t progress_percent = 0;
 	uint16_t LGT_feedrate = 0;
+	// values are queued in ascending VP order so adjacent ones share a frame
 	switch (menu_type)
 	{
 	case eMENU_HOME:
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_E, (int16_t)thermalManager.current_temperature[0]);
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_B, (int16_t)thermalManager.current_temperature_bed);
+	case eMENU_UTILI_FILA:
+	case eMENU_HOME_FILA:
+		LGT_Send_Temperatures(false);
 		break;
 	case eMENU_TUNE:
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_E, (int16_t)thermalManager.current_temperature[0]);
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_B, (int16_t)thermalManager.current_temperature_bed);
-		LGT_Get_MYSERIAL1_Cmd();
-		LGT_Send_Data_To_Screen(ADDR_VAL_FAN,fanSpeeds[0]);
-		LGT_Send_Data_To_Screen(ADDR_VAL_FEED,feedrate_percentage);
-		LGT_Send_Data_To_Screen(ADDR_VAL_FLOW,planner.flow_percentage[0]);
+		LGT_Send_Temperatures(false);
+		LGT_Send_Changed_Data(ADDR_VAL_FAN,fanSpeeds[0]);
+		LGT_Send_Changed_Data(ADDR_VAL_FEED,feedrate_percentage);
+		LGT_Send_Changed_Data(ADDR_VAL_FLOW,planner.flow_percentage[0]);
 		break;
 	case eMENU_MOVE:
-		LGT_Send_Data_To_Screen(ADDR_VAL_MOVE_POS_X, (int16_t)(current_position[X_AXIS] * 10));
-		LGT_Send_Data_To_Screen(ADDR_VAL_MOVE_POS_Y, (int16_t)(current_position[Y_AXIS] * 10));
-		LGT_Send_Data_To_Screen(ADDR_VAL_MOVE_POS_Z, (int16_t)(current_position[Z_AXIS] * 10));
-		LGT_Send_Data_To_Screen(ADDR_VAL_MOVE_POS_E, (int16_t)(current_position[E_AXIS] * 10));
+		LGT_Send_Changed_Data(ADDR_VAL_MOVE_POS_X, (int16_t)(current_position[X_AXIS] * 10));
+		LGT_Send_Changed_Data(ADDR_VAL_MOVE_POS_Y, (int16_t)(current_position[Y_AXIS] * 10));
+		LGT_Send_Changed_Data(ADDR_VAL_MOVE_POS_Z, (int16_t)(current_position[Z_AXIS] * 10));
+		LGT_Send_Changed_Data(ADDR_VAL_MOVE_POS_E, (int16_t)(current_position[E_AXIS] * 10));
 		break;
 	case eMENU_TUNE_E:
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_E, (int16_t)thermalManager.current_temperature[0]);
-		break;
 	case eMENU_TUNE_B:
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_B, (int16_t)thermalManager.current_temperature_bed);
+		LGT_Send_Temperatures(false);
 		break;
 	case eMENU_TUNE_FAN:
-		LGT_Send_Data_To_Screen(ADDR_VAL_FAN,fanSpeeds[0]);
+		LGT_Send_Changed_Data(ADDR_VAL_FAN,fanSpeeds[0]);
 		break;
 	case eMENU_TUNE_SPEED:
-		LGT_Send_Data_To_Screen(ADDR_VAL_FEED,feedrate_percentage);
+		LGT_Send_Changed_Data(ADDR_VAL_FEED,feedrate_percentage);
 		LGT_feedrate = (uint16_t)(MMS_SCALED(feedrate_mm_s) * 10);
 		if (LGT_feedrate > 3000)
 			LGT_feedrate = 3000;
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_FEED, LGT_feedrate);
+		LGT_Send_Changed_Data(ADDR_VAL_CUR_FEED, LGT_feedrate);
 		break;
 	case eMENU_TUNE_FLOW:
-		LGT_Send_Data_To_Screen(ADDR_VAL_FLOW,planner.flow_percentage[0]);
-		break;
-	case eMENU_UTILI_FILA:
-	case eMENU_HOME_FILA:
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_E, (int16_t)thermalManager.current_temperature[0]);
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_B, (int16_t)thermalManager.current_temperature_bed);
+		LGT_Send_Changed_Data(ADDR_VAL_FLOW,planner.flow_percentage[0]);
 		break;
 	case eMENU_PRINT_HOME:
+		LGT_Send_Temperatures(false);
+		Duration_Time = (print_job_timer.duration()) + recovery_time;
+		if (LGT_Cache_Check(ADDR_TXT_HOME_ELAP_TIME, (int16_t)Duration_Time.minute()))  // shown as hh:mm
+		{
+			LGT_Cache_Store(ADDR_TXT_HOME_ELAP_TIME, (int16_t)Duration_Time.minute());
+			memset(total_time, 0, sizeof(total_time));
+			Duration_Time.toDigital(total_time);
+			// pad the text over its whole slot so the progress word follows it
+			unsigned char elap_time[2 * LEN_6_CHR] = { 0 };
+			memcpy(elap_time, total_time, sizeof(total_time));
+			LGT_Burst_Add(ADDR_TXT_HOME_ELAP_TIME, elap_time, sizeof(elap_time));
+		}
 		progress_percent = card.percentDone();
 		if(progress_percent>0)
-			LGT_Send_Data_To_Screen(ADDR_VAL_HOME_PROGRESS, (uint16_t)progress_percent);
+			LGT_Send_Changed_Data(ADDR_VAL_HOME_PROGRESS, (uint16_t)progress_percent);
 		else
-			LGT_Send_Data_To_Screen(ADDR_VAL_HOME_PROGRESS, (uint16_t)recovery_percent);
-
-		Duration_Time = (print_job_timer.duration()) + recovery_time;
-		Duration_Time.toDigital(total_time);
-		LGT_Send_Data_To_Screen(ADDR_TXT_HOME_ELAP_TIME,total_time);
-		//delay(10);
-		LGT_Send_Data_To_Screen(ADDR_VAL_HOME_Z_HEIGHT, (int16_t)((current_position[Z_AXIS] + recovery_z_height) * 10));  //Current Z height
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_E, (int16_t)thermalManager.current_temperature[0]);
-		LGT_Send_Data_To_Screen(ADDR_VAL_CUR_B, (int16_t)thermalManager.current_temperature_bed);
+			LGT_Send_Changed_Data(ADDR_VAL_HOME_PROGRESS, (uint16_t)recovery_percent);
+		LGT_Send_Changed_Data(ADDR_VAL_HOME_Z_HEIGHT, (int16_t)((current_position[Z_AXIS] + recovery_z_height) * 10));  //Current Z height
 		break;
 	default:
 		break;
 	}
+	LGT_Burst_Flush();
 }
 void LGT_SCR::LGT_Printer_Light_Update()
 {
@@ -1621,6 +1759,7 @@ void LGT_SCR::LGT_Printer_Light_Update()
 		status_type = PRINTER_STANDBY;
 	}
 		LGT_Printer_Status_Light();
+		LGT_LED_Effect_Update();
 }
 
 void LGT_SCR::LGT_Power_Loss_Recovery_Resume() {
@@ -1658,13 +1797,6 @@ sta:disable or enable  (0000:disable  0001:enable)
 **************************************/
 void LGT_SCR::LGT_Disable_Enable_Screen_Button(unsigned int pageid, unsigned int buttonid, unsigned int sta) 
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x0B;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = 0x00;
-	data_storage[5] = 0xB0;
 	data_storage[6] = 0x5A;
 	data_storage[7] = 0xA5;
 	data_storage[8] = (unsigned char)(pageid>>8);
@@ -1673,21 +1805,10 @@ void LGT_SCR::LGT_Disable_Enable_Screen_Button(unsigned int pageid, unsigned int
 	data_storage[11] = (unsigned char)(buttonid & 0x00FF);
 	data_storage[12] = (unsigned char)(sta >> 8);
 	data_storage[13] = (unsigned char)(sta & 0x00FF);
-	for (int i = 0; i < 14; i++)
-	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
-	}
+	LGT_Send_VAR_Frame(0x00B0, 8);
 }
 void LGT_SCR::LGT_Save_Recovery_Filename(unsigned char cmd, unsigned char sys_cmd,unsigned int addr, unsigned int length)
 {
-	memset(data_storage, 0, sizeof(data_storage));
-	data_storage[0] = Send_Data.head[0];
-	data_storage[1] = Send_Data.head[1];
-	data_storage[2] = 0x0B;
-	data_storage[3] = DW_CMD_VAR_W;
-	data_storage[4] = 0x00;
-	data_storage[5] = 0x08;
 	data_storage[6] = sys_cmd;
 	data_storage[7] = 0x00;
 	data_storage[8] = 0x00;
@@ -1696,11 +1817,7 @@ void LGT_SCR::LGT_Save_Recovery_Filename(unsigned char cmd, unsigned char sys_cm
 	data_storage[11] = (unsigned char)(addr & 0x00FF);
 	data_storage[12] = (unsigned char)(length >> 8);
 	data_storage[13] = (unsigned char)(length & 0x00FF);
-	for (int i = 0; i < 14; i++)
-	{
-		MYSERIAL1.print(data_storage[i]);
-		delayMicroseconds(1);
-	}
+	LGT_Send_VAR_Frame(0x0008, 8);
 }
 /*************************************
 FUNCTION:	The main function of DWIN_Screen
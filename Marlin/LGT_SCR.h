@@ -6,6 +6,7 @@
 #include "temperature.h"
 #include "duration_t.h"
 #include"LGT_MACRO.h"
+#include "eeprom_ring.h"
 #include "power_loss_recovery.h"
 #include "planner.h"
 #include "parser.h"
@@ -40,6 +41,12 @@ enum PRINTER_STATUS
 	PRINTER_PAUSE,
 	PRINTER_PRINTING_F
 };
+enum LED_EFFECT : uint8_t
+{
+	eLED_OFF = 0,
+	eLED_BREATHE,
+	eLED_SOLID
+};
 enum PRINTER_KILL_STATUS
 {
 	PRINTER_NORMAL = 0,
@@ -61,7 +68,9 @@ class LGT_SCR
 {
 public:
 	LGT_SCR();
-	void LED_Bright_State(uint8_t LED, uint16_t per, uint8_t mod);
+	void LGT_Set_LED_Effect(uint8_t LED, LED_EFFECT effect, uint16_t period, bool hold = false);
+	void LGT_Release_LED_Effect();
+	void LGT_LED_Effect_Update();
 	void LGT_MAC_Send_Filename(uint16_t Addr, uint16_t i);
 	void LGT_Print_Cause_Of_Kill();
 	void LGT_Get_MYSERIAL1_Cmd();
@@ -70,8 +79,20 @@ public:
 	void LGT_Send_Data_To_Screen(unsigned int addr, float num,char axis);
 	void LGT_Send_Data_To_Screen(unsigned int addr,char* buf);
 	void LGT_Send_Data_To_Screen1(unsigned int addr,const char* buf);
+	void LGT_Send_VAR_Frame(uint16_t addr, uint8_t len);
+	void LGT_Send_Changed_Data(uint16_t Addr, int16_t Num);
+	void LGT_Send_Temperatures(bool force);
+	void LGT_Burst_Add(uint16_t addr, const unsigned char* buf, uint8_t len);
+	void LGT_Burst_Add(uint16_t Addr, int16_t Num);
+	void LGT_Burst_Flush();
+	bool LGT_Cache_Check(uint16_t Addr, int16_t Num);
+	void LGT_Cache_Store(uint16_t Addr, int16_t Num);
+	void LGT_Cache_Invalidate(uint16_t Addr);
+	void LGT_Cache_Clear();
+	void LGT_Cache_Report(bool reset);
 	void LGT_Main_Function();
 	void LGT_Display_Filename();
+	void LGT_Send_Filename_Page();
 	void LGT_Clean_DW_Display_Data(unsigned int addr);
 	void LGT_SDCard_Status_Update();
 	void LGT_Change_Page(unsigned int pageid);
@@ -79,6 +100,7 @@ public:
 	void LGT_Disable_Enable_Screen_Button(unsigned int pageid, unsigned int buttonid, unsigned int sta);
 	void LGT_Screen_System_Reset();
 	void LGT_Stop_Printing();
+	void LGT_Stop_Printing_Done();
 	void LGT_Exit_Print_Page();
 	int LGT_Get_Extrude_Temp();
 	void LGT_Save_Recovery_Filename(unsigned char cmd, unsigned char sys_cmd, /*unsigned int sys_addr,*/unsigned int addr, unsigned int length);
@@ -87,6 +109,8 @@ public:
 	void LGT_Printer_Data_Updata();
 	void LGT_DW_Setup();
 	void LGT_Change_Filament(int fila_len);
+	void LGT_Change_Filament_Done(int fila_len);
+	void LGT_Run_Screen_Job();
 };
 #define CHANGE_TXT_COLOR(addr,color)	LGT_Send_Data_To_Screen((uint16_t)addr,(int16_t)color)
 #define SP_COLOR_SEL_FILE_NAME			(SP_COLOR_TXT_PRINT_FILE_ITEM_0 + sel_fileid*LEN_FILE_NAME)
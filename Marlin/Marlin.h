@@ -236,8 +236,17 @@ bool enqueue_and_echo_command(const char* cmd);           // Add a single comman
 void enqueue_and_echo_commands_P(const char * const cmd); // Set one or more commands to be prioritized over the next Serial/SD command.
 void clear_command_queue();
 
+// The command queue packs commands into one arena of this many bytes
+#define COMMAND_QUEUE_SIZE ((BUFSIZE) * (MAX_CMD_SIZE))
+
 #if ENABLED(M100_FREE_MEMORY_WATCHER) || ENABLED(POWER_LOSS_RECOVERY)
-  extern char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  extern char command_queue[COMMAND_QUEUE_SIZE];
+#endif
+
+extern uint8_t commands_in_queue;
+
+#if ENABLED(POWER_LOSS_RECOVERY)
+  uint32_t queued_command_sdpos();
 #endif
 
 #define HAS_LCD_QUEUE_NOW (ENABLED(MALYAN_LCD) || (ENABLED(ULTIPANEL) && (ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(PID_AUTOTUNE_MENU) || ENABLED(ADVANCED_PAUSE_FEATURE))))
@@ -39,6 +39,7 @@
 
   #include "MarlinSerial.h"
   #include "Marlin.h"
+  #include "cycle_profiler.h"
 
   struct ring_buffer_r {
     unsigned char buffer[RX_BUFFER_SIZE];
@@ -371,7 +372,7 @@
   #endif // TX_BUFFER_SIZE
 
   #ifdef M_USARTx_RX_vect
-    ISR(M_USARTx_RX_vect) { store_rxd_char(); }
+    ISR(M_USARTx_RX_vect) { PROFILE_SCOPE(SERIAL_RX_ISR); store_rxd_char(); }
   #endif
 
   // Public Methods
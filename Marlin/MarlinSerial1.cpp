@@ -41,6 +41,7 @@
 
   #include "MarlinSerial1.h"
   #include "Marlin.h"
+  #include "cycle_profiler.h"
 #if ENABLED(EMERGENCY_PARSER)
 #include "emergency_parser.h"
 #endif
@@ -294,7 +295,7 @@
   #endif // TX_BUFFER_SIZE
 
   #ifdef M_USARTx_RX_vect1
-    ISR(M_USARTx_RX_vect1) { store_rxd_char1(); }
+    ISR(M_USARTx_RX_vect1) { PROFILE_SCOPE(SERIAL1_RX_ISR); store_rxd_char1(); }
   #endif
 
   // Public Methods
@@ -470,6 +471,40 @@
       return;
     }
 
+    /**
+     * Queue a whole block (e.g. a DWIN frame) for the UDRE ISR.
+     * The buffer is filled outside of the critical section (the ISR only
+     * moves the tail) and the head is published once per chunk, so a frame
+     * that fits the buffer costs a copy instead of a wait per byte.
+     */
+    void MarlinSerial1::write(const uint8_t* buffer, size_t size) {
+      #if ENABLED(SERIAL_XON_XOFF)
+        while (size--) write(*buffer++);
+      #else
+        if (!size) return;
+        _written1 = true;
+        for (;;) {
+          uint8_t h = tx_buffer1.head;
+          const uint8_t t = tx_buffer1.tail;
+          for (uint8_t i; size && (i = (h + 1) & (TX_BUFFER_SIZE1 - 1)) != t; h = i, size--)
+            tx_buffer1.buffer[h] = *buffer++;
+
+          if (h != tx_buffer1.head) {
+            CRITICAL_SECTION_START;
+              tx_buffer1.head = h;
+              SBI(M_UCSRxB1, M_UDRIEx1);
+            CRITICAL_SECTION_END;
+          }
+          if (!size) return;
+
+          // Buffer full: wait for the ISR to make room, or do its job if
+          // interrupts are disabled (see writeNoHandshake)
+          if (!TEST(SREG, SREG_I) && TEST(M_UCSRxA1, M_UDREx1))
+            _tx_udr_empty_irq1();
+        }
+      #endif
+    }
+
     void MarlinSerial1::flushTX(void) {
       // TX
       // If we have never written a byte, no need to flush. This special
@@ -272,6 +272,15 @@
 #include "types.h"
 #include "parser.h"
 #include "LGT_SCR.h"
+#include "idle_tasks.h"
+
+#if ENABLED(MOTION_STATS)
+  #include "motion_stats.h"
+#endif
+
+#if ENABLED(CYCLE_PROFILER)
+  #include "cycle_profiler.h"
+#endif
 
 #if ENABLED(AUTO_POWER_CONTROL)
   #include "power.h"
@@ -352,6 +361,10 @@
   void gcode_G26();
 #endif
 
+#if ENABLED(IDLE_TASK_STATS)
+  void gcode_M2011();
+#endif
+
 #if ENABLED(SDSUPPORT)
   CardReader card;
 #endif
@@ -414,18 +427,39 @@ static long gcode_N, gcode_LastN, Stopped_gcode_LastN = 0;
 
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A ring buffer of variable-length entries packed into one arena of
+ * COMMAND_QUEUE_SIZE bytes. Each entry is a queued_command_t header
+ * followed by the null-terminated command, so a short G1 line takes
+ * only the bytes it needs instead of a whole MAX_CMD_SIZE slot.
  *
  * Commands are copied into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
  * the main loop. The process_next_command function parses the next
  * command and hands off execution to individual handler functions.
+ *
+ * An entry never wraps. When there isn't room for a full-length command
+ * before the end of the arena the writer starts over at 0, and
+ * cmd_queue_end marks where the reader must wrap. All producers and the
+ * single consumer run in the main loop, so no locking is needed.
  */
-uint8_t commands_in_queue = 0, // Count of commands in the queue
-        cmd_queue_index_r = 0, // Ring buffer read (out) position
-        cmd_queue_index_w = 0; // Ring buffer write (in) position
+typedef struct {
+  uint8_t size;       // Size of the whole entry, header included
+  bool send_ok;       // Send "ok" when the command has been processed
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    uint32_t sdpos;   // SD offset of the command, or JOB_RECOVERY_NO_SDPOS
+  #endif
+} queued_command_t;
+
+#define QUEUED(I)     ((queued_command_t*)&command_queue[I])
+#define QUEUED_CMD(I) (&command_queue[(I) + sizeof(queued_command_t)])
+#define QUEUE_ENTRY_MAX (sizeof(queued_command_t) + (MAX_CMD_SIZE))
 
-char command_queue[BUFSIZE][MAX_CMD_SIZE];
+uint8_t commands_in_queue = 0;              // Count of commands in the queue
+uint16_t cmd_queue_index_r = 0,             // Offset of the oldest entry (out)
+         cmd_queue_index_w = 0,             // Offset for the next entry (in)
+         cmd_queue_end = COMMAND_QUEUE_SIZE; // Reader wraps here
+
+char command_queue[COMMAND_QUEUE_SIZE];
 
 /**
  * Next Injected Command pointer. NULL if no commands are being injected.
@@ -669,6 +703,12 @@ uint8_t target_extruder;
     #define ABL_BG_POINTS_Y   GRID_MAX_POINTS_Y
     #define ABL_BG_GRID(X,Y)  z_values[X][Y]
   #endif
+
+  #if ENABLED(BILINEAR_CELL_COEFFICIENTS)
+    typedef struct { int16_t a, b, c, d; } abl_cell_t;
+    static abl_cell_t abl_cells[ABL_BG_POINTS_X - 1][ABL_BG_POINTS_Y - 1];
+    static_assert(sizeof(abl_cells) <= 1024, "Too many bilinear cells for BILINEAR_CELL_COEFFICIENTS. Disable it or use a smaller grid.");
+  #endif
 #endif
 
 #if IS_SCARA
@@ -705,8 +745,6 @@ float cartes[XYZ] = { 0 };
   #endif
 #endif
 
-static bool send_ok[BUFSIZE];
-
 #if HAS_SERVOS
   Servo servo[NUM_SERVOS];
   #define MOVE_SERVO(I, P) servo[I].move(P)
@@ -767,6 +805,9 @@ XYZ_CONSTS_FROM_CONFIG(signed char, home_dir, HOME_DIR);
 	extern bool LGT_is_printing,LGT_stop_printing,leveling_wait,return_home;
 	extern char menu_move_dis_chk,menu_fila_type_chk;
 	extern void LGT_Line_To_Current(AxisEnum axis);
+	extern void LGT_Save_Total_Time();
+	extern uint32_t LGT_Load_Total_Time();
+	extern uint32_t total_print_time;
 	void DWIN_MAIN_FUNCTIONS();
 	void LGT_Pause_Move()
 	{
@@ -955,14 +996,46 @@ void enqueue_and_echo_commands_P(const char * const pgcode) {
  */
 void clear_command_queue() {
   cmd_queue_index_r = cmd_queue_index_w = commands_in_queue = 0;
+  cmd_queue_end = COMMAND_QUEUE_SIZE;
+}
+
+/**
+ * Get the offset where a full-length command can be written,
+ * or -1 if the queue has no room for one right now.
+ */
+int16_t next_command_slot() {
+  if (!commands_in_queue) {
+    // Empty: start over at the front for the most contiguous room
+    cmd_queue_index_r = cmd_queue_index_w = 0;
+    cmd_queue_end = COMMAND_QUEUE_SIZE;
+    return 0;
+  }
+  if (cmd_queue_index_w > cmd_queue_index_r) {
+    if (COMMAND_QUEUE_SIZE - cmd_queue_index_w >= QUEUE_ENTRY_MAX) return cmd_queue_index_w;
+    if (cmd_queue_index_r >= QUEUE_ENTRY_MAX) return 0; // wrap to the front
+  }
+  else if (cmd_queue_index_w < cmd_queue_index_r) {
+    if (cmd_queue_index_r - cmd_queue_index_w >= QUEUE_ENTRY_MAX) return cmd_queue_index_w;
+  }
+  return -1;
 }
 
 /**
- * Once a new command is in the ring buffer, call this to commit it
+ * Once a new command is in the slot from next_command_slot(), call this to commit it
  */
-inline void _commit_command(bool say_ok) {
-  send_ok[cmd_queue_index_w] = say_ok;
-  if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
+inline void _commit_command(const uint16_t slot, bool say_ok
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    , const uint32_t sdpos=JOB_RECOVERY_NO_SDPOS
+  #endif
+) {
+  if (slot != cmd_queue_index_w) cmd_queue_end = cmd_queue_index_w; // writer wrapped
+  queued_command_t * const entry = QUEUED(slot);
+  entry->size = sizeof(queued_command_t) + strlen(QUEUED_CMD(slot)) + 1;
+  entry->send_ok = say_ok;
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    entry->sdpos = sdpos;
+  #endif
+  cmd_queue_index_w = slot + entry->size;
   commands_in_queue++;
 }
 
@@ -972,12 +1045,41 @@ inline void _commit_command(bool say_ok) {
  * Return false for a full buffer, or if the 'command' is a comment.
  */
 inline bool _enqueuecommand(const char* cmd, bool say_ok=false) {
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
-  strcpy(command_queue[cmd_queue_index_w], cmd);
-  _commit_command(say_ok);
+  if (*cmd == ';') return false;
+  const int16_t slot = next_command_slot();
+  if (slot < 0) return false;
+  strcpy(QUEUED_CMD(slot), cmd);
+  _commit_command(slot, say_ok);
   return true;
 }
 
+/**
+ * Number of full-length commands that are sure to fit in the queue
+ */
+uint8_t free_command_slots() {
+  if (!commands_in_queue) return COMMAND_QUEUE_SIZE / QUEUE_ENTRY_MAX;
+  if (cmd_queue_index_w > cmd_queue_index_r)
+    return (COMMAND_QUEUE_SIZE - cmd_queue_index_w) / QUEUE_ENTRY_MAX + cmd_queue_index_r / QUEUE_ENTRY_MAX;
+  return (cmd_queue_index_r - cmd_queue_index_w) / QUEUE_ENTRY_MAX;
+}
+
+#if ENABLED(POWER_LOSS_RECOVERY)
+  /**
+   * SD offset of the first SD command queued behind the one being
+   * processed, or JOB_RECOVERY_NO_SDPOS if there is none
+   */
+  uint32_t queued_command_sdpos() {
+    uint16_t i = cmd_queue_index_r, end = cmd_queue_end;
+    for (uint8_t c = 1; c < commands_in_queue; c++) {
+      i += QUEUED(i)->size;
+      if (i >= end) { i = 0; end = COMMAND_QUEUE_SIZE; }
+      const uint32_t sdpos = QUEUED(i)->sdpos;
+      if (sdpos != JOB_RECOVERY_NO_SDPOS) return sdpos;
+    }
+    return JOB_RECOVERY_NO_SDPOS;
+  }
+#endif
+
 /**
  * Enqueue with Serial Echo
  */
@@ -1117,7 +1219,7 @@ inline void get_serial_commands() {
    * Loop while serial characters are incoming and the queue is not full
    */
   int c;
-  while (commands_in_queue < BUFSIZE && (((c = MYSERIAL0.read()) >= 0) )) 
+  while (next_command_slot() >= 0 && (((c = MYSERIAL0.read()) >= 0) )) 
   {
     char serial_char = c;
 
@@ -1243,8 +1345,7 @@ inline void get_serial_commands() {
    * can also interrupt buffering.
    */
   inline void get_sdcard_commands() {
-    static bool stop_buffering = false,
-                sd_comment_mode = false;
+    static bool stop_buffering = false;
 
     if (!card.sdprinting) return;
 
@@ -1257,69 +1358,55 @@ inline void get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
-    uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (commands_in_queue < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      if (card_eof || n == -1
-          || sd_char == '\n' || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
+    int16_t slot;
+    while ((slot = next_command_slot()) >= 0 && !card.eof() && !stop_buffering) {
+      #if ENABLED(POWER_LOSS_RECOVERY)
+        const uint32_t sdpos = card.getIndex();
+      #endif
+      char sd_char;
+      const int16_t sd_count = card.read_line(QUEUED_CMD(slot), MAX_CMD_SIZE, sd_char);
+      if (sd_count < 0) {
+        SERIAL_ERROR_START();
+        SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
+        break;
+      }
 
-          card.printingHasFinished();
+      if (card.eof()) {
 
-          if (card.sdprinting)
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-              leds.set_green();
-              #if HAS_RESUME_CONTINUE
-                lights_off_after_print = true;
-                enqueue_and_echo_commands_P(PSTR("M0 S"
-                  #if ENABLED(NEWPANEL)
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #else
-                safe_delay(2000);
-                leds.set_off();
-              #endif
-            #endif // PRINTER_EVENT_LEDS
-          }
-        }
-        else if (n == -1) {
-          SERIAL_ERROR_START();
-          SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
-        }
-        if (sd_char == '#') stop_buffering = true;
+        card.printingHasFinished();
 
-        sd_comment_mode = false; // for new command
+        if (!card.sdprinting) {
+          SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
+          #if ENABLED(PRINTER_EVENT_LEDS)
+            LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+            leds.set_green();
+            #if HAS_RESUME_CONTINUE
+              lights_off_after_print = true;
+              enqueue_and_echo_commands_P(PSTR("M0 S"
+                #if ENABLED(NEWPANEL)
+                  "1800"
+                #else
+                  "60"
+                #endif
+              ));
+            #else
+              safe_delay(2000);
+              leds.set_off();
+            #endif
+          #endif // PRINTER_EVENT_LEDS
+        }
+      }
 
-        // Skip empty lines and comments
-        if (!sd_count) { thermalManager.manage_heater(); continue; }
+      if (sd_char == '#') stop_buffering = true;
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+      // Skip empty lines and comments
+      if (!sd_count) { thermalManager.manage_heater(); continue; }
 
-        _commit_command(false);
-      }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
-      }
+      _commit_command(slot, false
+        #if ENABLED(POWER_LOSS_RECOVERY)
+          , sdpos
+        #endif
+      );
     }
   }
 
@@ -1659,6 +1746,18 @@ inline float get_homing_bump_feedrate(const AxisEnum axis) {
   return homing_feedrate(axis) / hbd;
 }
 
+/**
+ * Homing first approach feedrate (mm/s)
+ */
+inline float get_homing_approach_feedrate(const AxisEnum axis) {
+  #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE) && defined(HOMING_FAST_APPROACH)
+    // An endstop on an interrupt pin stops the axis on the step that triggers it
+    if (axis == X_AXIS ? X_HOME_IRQ : axis == Y_AXIS ? Y_HOME_IRQ : (axis == Z_AXIS && Z_HOME_IRQ))
+      return homing_feedrate(axis) * (HOMING_FAST_APPROACH);
+  #endif
+  return homing_feedrate(axis);
+}
+
 /**
  * Some planner shorthand inline functions
  */
@@ -2407,8 +2506,15 @@ void clean_up_after_endstop_or_probe_move() {
     // Double-probing does a fast probe followed by a slow probe
     #if MULTIPLE_PROBING == 2
 
+      #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE) && defined(HOMING_FAST_APPROACH) && Z_PROBE_IRQ
+        // The probe stops Z on the step that triggers it
+        const float fast_probe_fr = MMM_TO_MMS(Z_PROBE_SPEED_FAST) * (HOMING_FAST_APPROACH);
+      #else
+        const float fast_probe_fr = MMM_TO_MMS(Z_PROBE_SPEED_FAST);
+      #endif
+
       // Do a first probe at the fast speed
-      if (do_probe_move(z_probe_low_point, MMM_TO_MMS(Z_PROBE_SPEED_FAST))) {
+      if (do_probe_move(z_probe_low_point, fast_probe_fr)) {
         #if ENABLED(DEBUG_LEVELING_FEATURE)
           if (DEBUGGING(LEVELING)) {
             SERIAL_ECHOLNPGM("FAST Probe fail!");
@@ -3008,6 +3114,32 @@ void clean_up_after_endstop_or_probe_move() {
     }
   #endif // ABL_BILINEAR_SUBDIVISION
 
+  #if ENABLED(BILINEAR_CELL_COEFFICIENTS)
+
+    // Corner heights in microns, or 0 where a point is unprobed
+    #define ABL_CELL_UM(X,Y) (isnan(ABL_BG_GRID(X,Y)) ? 0L : LROUND(ABL_BG_GRID(X,Y) * 1000.0f))
+    #define ABL_CELL_CLAMP(V) int16_t(constrain(V, -32767L, 32767L))
+
+    /**
+     * Rebuild the cell coefficients: z(u,v) = a + b*u + c*v + d*u*v,
+     * where u and v run from 0 to 1 (0 to 4096 in bilinear_z_offset) across
+     * the cell. Derived from rounded corners, so cells still meet exactly.
+     */
+    static void bilinear_cells_refresh() {
+      for (uint8_t x = 0; x < ABL_BG_POINTS_X - 1; x++)
+        for (uint8_t y = 0; y < ABL_BG_POINTS_Y - 1; y++) {
+          const int32_t z00 = ABL_CELL_UM(x, y),     z10 = ABL_CELL_UM(x + 1, y),
+                        z01 = ABL_CELL_UM(x, y + 1), z11 = ABL_CELL_UM(x + 1, y + 1);
+          abl_cell_t &cell = abl_cells[x][y];
+          cell.a = ABL_CELL_CLAMP(z00);
+          cell.b = ABL_CELL_CLAMP(z10 - z00);
+          cell.c = ABL_CELL_CLAMP(z01 - z00);
+          cell.d = ABL_CELL_CLAMP(z11 - z10 - z01 + z00);
+        }
+    }
+
+  #endif // BILINEAR_CELL_COEFFICIENTS
+
   // Refresh after other values have been updated
   void refresh_bed_level() {
     bilinear_grid_factor[X_AXIS] = RECIPROCAL(bilinear_grid_spacing[X_AXIS]);
@@ -3015,6 +3147,9 @@ void clean_up_after_endstop_or_probe_move() {
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
       bed_level_virt_interpolate();
     #endif
+    #if ENABLED(BILINEAR_CELL_COEFFICIENTS)
+      bilinear_cells_refresh();
+    #endif
   }
 
 #endif // AUTO_BED_LEVELING_BILINEAR
@@ -3225,7 +3360,7 @@ static void homeaxis(const AxisEnum axis) {
     if (axis == Z_AXIS && set_bltouch_deployed(true)) return;
   #endif
 
-  do_homing_move(axis, 1.5f * max_length(axis) * axis_home_dir);
+  do_homing_move(axis, 1.5f * max_length(axis) * axis_home_dir, get_homing_approach_feedrate(axis));
 
   #if HOMING_Z_WITH_PROBE && ENABLED(BLTOUCH)
     // BLTOUCH needs to be stowed after trigger to rearm itself
@@ -5022,9 +5157,7 @@ void home_all_axes() { gcode_G28(true); }
           if (WITHIN(i, 0, GRID_MAX_POINTS_X - 1) && WITHIN(j, 0, GRID_MAX_POINTS_Y)) {
             set_bed_leveling_enabled(false);
             z_values[i][j] = rz;
-            #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-              bed_level_virt_interpolate();
-            #endif
+            refresh_bed_level();
             set_bed_leveling_enabled(abl_should_enable);
             if (abl_should_enable) report_current_position();
           }
@@ -10325,6 +10458,8 @@ inline void gcode_M226() {
     if (parser.seen('I')) thermalManager.bedKi = scalePID_i(parser.value_float());
     if (parser.seen('D')) thermalManager.bedKd = scalePID_d(parser.value_float());
 
+    thermalManager.updatePID();
+
     SERIAL_ECHO_START();
     SERIAL_ECHOPAIR(" p:", thermalManager.bedKp);
     SERIAL_ECHOPAIR(" i:", unscalePID_i(thermalManager.bedKi));
@@ -10787,8 +10922,8 @@ void quickstop_stepper() {
             for (uint8_t x = GRID_MAX_POINTS_X; x--;)
               for (uint8_t y = GRID_MAX_POINTS_Y; y--;)
                 Z_VALUES(x, y) -= zmean;
-            #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-              bed_level_virt_interpolate();
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              refresh_bed_level();
             #endif
           }
 
@@ -10904,9 +11039,7 @@ void quickstop_stepper() {
     }
     else {
       z_values[ix][iy] = parser.value_linear_units() + (hasQ ? z_values[ix][iy] : 0);
-      #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-        bed_level_virt_interpolate();
-      #endif
+      refresh_bed_level();
     }
   }
 
@@ -12837,12 +12970,51 @@ inline void gcode_T(const uint8_t tmp_extruder) {
   #endif
 }
 
+#if ENABLED(STEP_ISR_GOVERNOR)
+  /**
+   * M2015: Report the Stepper ISR load, its overruns and the feedrate governor
+   *
+   *   R - Reset the peak load and the counters after reporting
+   */
+  inline void gcode_M2015() {
+    uint32_t rate;
+    uint8_t window;
+    const uint8_t load = stepper.isr_load(rate, window);
+    NOLESS(planner.governor_load_peak, load);
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("Stepper ISR load:", load);
+    SERIAL_ECHOPAIR("% peak:", planner.governor_load_peak);
+    SERIAL_ECHOPAIR("% overruns:", stepper.isr_overruns);
+    SERIAL_ECHOPAIR(" governed blocks:", planner.governed_blocks);
+    SERIAL_ECHOPGM(" cap:");
+    if (planner.governor_rate) {
+      SERIAL_ECHO(planner.governor_rate);
+      SERIAL_ECHOLNPGM(" steps/s");
+    }
+    else
+      SERIAL_ECHOLNPGM("off");
+
+    if (parser.seen('R')) {
+      planner.governor_load_peak = 0;
+      planner.governed_blocks = 0;
+      CRITICAL_SECTION_START;
+      stepper.isr_overruns = 0;
+      CRITICAL_SECTION_END;
+    }
+  }
+#endif
+
 /**
  * Process the parsed command and dispatch it to its handler
  */
 void process_parsed_command() {
   KEEPALIVE_STATE(IN_HANDLER);
 
+  #if ENABLED(MOTION_STATS)
+    motion_stats.command(parser.command_letter, parser.codenum);
+  #endif
+
   // Handle a known G, M, or T
   switch (parser.command_letter) {
     case 'G': switch (parser.codenum) {
@@ -13387,14 +13559,51 @@ void process_parsed_command() {
 			  planner.set_e_position_mm((destination[E_CART] = current_position[E_CART] = 0));
 		  }
 		  break;
-	  case 2008:
-		  for (int add = EEPROM_INDEX; add < (EEPROM_INDEX + 4); add++)
+	  case 2008:   //reset the total print time
+		  total_print_time = 0;
+		  LGT_Save_Total_Time();
+		  MYSERIAL0.println(LGT_Load_Total_Time());
+		break;
+	  case 2009:   //report DWIN screen variable cache hits/misses, R to reset
+		  LGT_LCD.LGT_Cache_Report(parser.seen('R'));
+		  break;
+	#if ENABLED(SDSUPPORT)
+	  case 2010:   //report SD block cache hits/misses, R to reset
+		  card.reportCacheStats(parser.seen('R'));
+		  break;
+	#endif
+	#ifdef U20_Pro
+	  case 2012:   //status LED effect: C<0 red,1 green,2 blue> P<0 off,1 breathe,2 solid> S<period ms>, no P to follow printer status
+		  if (parser.seen('P'))
 		  {
-			  eeprom_write_byte((uint8_t *)add, (uint8_t)0);
-			  MYSERIAL0.println((int)eeprom_read_byte((const uint8_t *)add));
+			  const LED_EFFECT effect = (LED_EFFECT)constrain(parser.value_byte(), eLED_OFF, eLED_SOLID);
+			  LGT_LCD.LGT_Set_LED_Effect(LED_RED + constrain(parser.byteval('C', 1), 0, 2), effect, parser.ushortval('S', 3000), true);
 		  }
-		break;
+		  else
+			  LGT_LCD.LGT_Release_LED_Effect();
+		  break;
+	#endif // U20_Pro
 #endif // LGT_MAC
+#if ENABLED(IDLE_TASK_STATS)
+	  case 2011:   //report idle task overruns and runtime histograms, R to reset
+		  gcode_M2011();
+		  break;
+#endif
+#if ENABLED(MOTION_STATS)
+	  case 2013:   //report planner time per block, underruns and max step rate, R to reset
+		  motion_stats.report(parser.seen('R'));
+		  break;
+#endif
+#if ENABLED(CYCLE_PROFILER)
+	  case 2014:   //report ISR and main loop task timings, R to reset
+		  profiler.report(parser.seen('R'));
+		  break;
+#endif
+#if ENABLED(STEP_ISR_GOVERNOR)
+	  case 2015:   //report stepper ISR load, overruns and governed blocks, R to reset
+		  gcode_M2015();
+		  break;
+#endif
 	 
       default: parser.unknown_command_error();
     }
@@ -13410,7 +13619,7 @@ void process_parsed_command() {
 }
 
 void process_next_command() {
-  char * const current_command = command_queue[cmd_queue_index_r];
+  char * const current_command = QUEUED_CMD(cmd_queue_index_r);
 
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
@@ -13421,6 +13630,17 @@ void process_next_command() {
     #endif
   }
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    // Blocks queued by an SD command are tagged with where it starts, so
+    // a recovery save knows where the block being executed came from
+    const uint32_t sdpos = QUEUED(cmd_queue_index_r)->sdpos;
+    if (sdpos != JOB_RECOVERY_NO_SDPOS) {
+      planner.command_sdpos = sdpos;
+      planner.command_start_z = current_position[Z_AXIS];
+      planner.command_start_e = current_position[E_AXIS];
+    }
+  #endif
+
   // Parse the next command in the queue
   parser.parse(current_command);
   process_parsed_command();
@@ -13448,10 +13668,10 @@ void flush_and_request_resend() {
  *   B<int>  Block queue space remaining
  */
 void ok_to_send() {
-  if (!send_ok[cmd_queue_index_r]) return;
+  if (commands_in_queue && !QUEUED(cmd_queue_index_r)->send_ok) return;
   SERIAL_PROTOCOLPGM(MSG_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_queue[cmd_queue_index_r];
+    char* p = QUEUED_CMD(cmd_queue_index_r);
     if (*p == 'N') {
       SERIAL_PROTOCOL(' ');
       SERIAL_ECHO(*p++);
@@ -13459,7 +13679,7 @@ void ok_to_send() {
         SERIAL_ECHO(*p++);
     }
     SERIAL_PROTOCOLPGM(" P"); SERIAL_PROTOCOL(int(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
-    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(BUFSIZE - commands_in_queue);
+    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(int(free_command_slots()));
   #endif
   SERIAL_EOL();
 }
@@ -13505,7 +13725,35 @@ void ok_to_send() {
 
 #endif
 
-#if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+#if ENABLED(AUTO_BED_LEVELING_BILINEAR) && ENABLED(BILINEAR_CELL_COEFFICIENTS)
+
+  // Get the Z adjustment for non-linear bed leveling
+  float bilinear_z_offset(const float raw[XYZ]) {
+
+    // XY relative to the probed area, in 1/4096 of a grid cell
+    const int32_t qx = (raw[X_AXIS] - bilinear_start[X_AXIS]) * (ABL_BG_FACTOR(X_AXIS) * 4096.0f),
+                  qy = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * (ABL_BG_FACTOR(Y_AXIS) * 4096.0f);
+
+    const int8_t cx = constrain(qx >> 12, 0, ABL_BG_POINTS_X - 2),
+                 cy = constrain(qy >> 12, 0, ABL_BG_POINTS_Y - 2);
+
+    #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
+      // Keep using the last grid box, up to 4 cells out
+      const int32_t u = constrain(qx - (int32_t(cx) << 12), -4 * 4096L, 5 * 4096L),
+                    v = constrain(qy - (int32_t(cy) << 12), -4 * 4096L, 5 * 4096L);
+    #else
+      // Beyond the grid maintain height at grid edges
+      const int32_t u = constrain(qx - (int32_t(cx) << 12), 0, 4096),
+                    v = constrain(qy - (int32_t(cy) << 12), 0, 4096);
+    #endif
+
+    // a + c*v + u*(b + d*v), rounding each product
+    const abl_cell_t &cell = abl_cells[cx][cy];
+    const int32_t bv = cell.b + ((cell.d * v + 2048) >> 12);
+    return (cell.a + ((cell.c * v + 2048) >> 12) + ((bv * u + 2048) >> 12)) * 0.001f;
+  }
+
+#elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
   // Get the Z adjustment for non-linear bed leveling
   float bilinear_z_offset(const float raw[XYZ]) {
@@ -13942,7 +14190,114 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
 }
 
 #if IS_CARTESIAN
-#if ENABLED(SEGMENT_LEVELED_MOVES)
+#if ENABLED(SEGMENT_LEVELED_MOVES) && ENABLED(AUTO_BED_LEVELING_BILINEAR) && defined(LEVELED_SEGMENT_TOLERANCE)
+
+  /**
+   * Fraction of the move at which grid position G0 + DG * t next
+   * reaches a grid line, or 2 if it reaches no more lines.
+   */
+  static float next_grid_line(const float &g0, const float &dg, const float &t, const uint8_t points) {
+    if (!dg) return 2;
+    const float g = g0 + dg * t;
+    // The bias skips the line a previous piece ended on. Outside the
+    // grid the next line is its first edge ahead, if there is one.
+    int8_t line;
+    if (dg > 0) {
+      line = MAX(int8_t(FLOOR(g + 0.001f)) + 1, 0);
+      if (line > points - 1) return 2;
+    }
+    else {
+      line = MIN(int8_t(CEIL(g - 0.001f)) - 1, points - 1);
+      if (line < 0) return 2;
+    }
+    return (line - g0) / dg;
+  }
+
+  /**
+   * Prepare an adaptively segmented move on a bilinear-leveled CARTESIAN setup.
+   *
+   * Inside a grid cell the correction is bilinear, so along a straight line it
+   * is a parabola bent only by the cell's twist (z00 - z10 - z01 + z11). The move
+   * is split where it crosses a grid line, and each piece is divided further only
+   * where its chord would stray from the mesh by more than LEVELED_SEGMENT_TOLERANCE.
+   * A piece is never cut finer than segment_size, so this never plans more blocks
+   * than fixed-length segmentation would.
+   */
+  inline void segmented_line_to_destination(const float &fr_mm_s, const float segment_size=LEVELED_SEGMENT_LENGTH) {
+
+    float diff[XYZE];
+    LOOP_XYZE(i) diff[i] = destination[i] - current_position[i];
+
+    // If the move is only in Z/E don't split up the move
+    if (!diff[X_AXIS] && !diff[Y_AXIS]) {
+      planner.buffer_line_kinematic(destination, fr_mm_s, active_extruder);
+      return;
+    }
+
+    // Get the linear distance in XYZ
+    // If the move is very short, check the E move distance
+    // No E move either? Game over.
+    float cartesian_mm = SQRT(sq(diff[X_AXIS]) + sq(diff[Y_AXIS]) + sq(diff[Z_AXIS]));
+    if (UNEAR_ZERO(cartesian_mm)) cartesian_mm = ABS(diff[E_CART]);
+    if (UNEAR_ZERO(cartesian_mm)) return;
+
+    // Start and span of the move in grid units
+    const float gx0 = (current_position[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
+                gy0 = (current_position[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS),
+                dgx = diff[X_AXIS] * ABL_BG_FACTOR(X_AXIS),
+                dgy = diff[Y_AXIS] * ABL_BG_FACTOR(Y_AXIS);
+
+    float raw[XYZE], t0 = 0;
+    while (t0 < 1) {
+      const float t1 = MIN3(next_grid_line(gx0, dgx, t0, ABL_BG_POINTS_X), next_grid_line(gy0, dgy, t0, ABL_BG_POINTS_Y), 1.0f),
+                  dt = t1 - t0,
+                  tm = t0 + dt * 0.5f,
+                  gx = gx0 + dgx * tm,
+                  gy = gy0 + dgy * tm;
+
+      // The chord of a parabola strays most at its middle, by a quarter of the bend
+      float twist = 0;
+      #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+        // Beyond the grid the height follows the edge, which has no twist
+        if (WITHIN(gx, 0, ABL_BG_POINTS_X - 1) && WITHIN(gy, 0, ABL_BG_POINTS_Y - 1))
+      #endif
+      {
+        const int8_t cx = constrain(int8_t(FLOOR(gx)), 0, ABL_BG_POINTS_X - 2),
+                     cy = constrain(int8_t(FLOOR(gy)), 0, ABL_BG_POINTS_Y - 2);
+        twist = ABL_BG_GRID(cx, cy) - ABL_BG_GRID(cx + 1, cy) - ABL_BG_GRID(cx, cy + 1) + ABL_BG_GRID(cx + 1, cy + 1);
+      }
+      const float stray = ABS(twist * dgx * dgy) * sq(dt) * 0.25f,
+                  piece_mm = cartesian_mm * dt;
+
+      uint16_t segments = 1;
+      if (stray > LEVELED_SEGMENT_TOLERANCE)
+        segments = MAX(1.0f, MIN(CEIL(SQRT(stray * (1.0f / (LEVELED_SEGMENT_TOLERANCE)))), CEIL(piece_mm / segment_size)));
+
+      const float segment_mm = piece_mm / segments;
+      const bool last_piece = t1 >= 1;
+      for (uint16_t s = 1; s <= segments; s++) {
+        static millis_t next_idle_ms = millis() + 200UL;
+        thermalManager.manage_heater();  // This returns immediately if not really needed.
+        if (ELAPSED(millis(), next_idle_ms)) {
+          next_idle_ms = millis() + 200UL;
+          idle();
+        }
+        // The final move must be to the exact destination
+        if (last_piece && s == segments) break;
+        const float t = t0 + dt * s / segments;
+        LOOP_XYZE(i) raw[i] = current_position[i] + diff[i] * t;
+        if (!planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder, segment_mm))
+          return;
+      }
+      if (last_piece) {
+        planner.buffer_line_kinematic(destination, fr_mm_s, active_extruder, segment_mm);
+        return;
+      }
+      t0 = t1;
+    }
+  }
+
+#elif ENABLED(SEGMENT_LEVELED_MOVES)
 
   /**
    * Prepare a segmented move on a CARTESIAN setup.
@@ -15004,7 +15359,7 @@ void manage_inactivity(const bool ignore_stepper_queue/*=false*/) {
     runout.run();
   #endif
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (next_command_slot() >= 0) get_available_commands();
 
   const millis_t ms = millis();
 
@@ -15196,59 +15551,111 @@ void manage_inactivity(const bool ignore_stepper_queue/*=false*/) {
 }
 
 /**
- * Standard idle routine keeps the machine alive
+ * Idle tasks, run in order by idle() when due.
+ * Budgets are the expected worst case in microseconds. M2011 reports
+ * overruns and a runtime histogram for each task.
  */
-void idle(
-  #if ENABLED(ADVANCED_PAUSE_FEATURE)
-    bool no_stepper_sleep/*=false*/
-  #endif
-) {
-  #if ENABLED(MAX7219_DEBUG)
-    max7219.idle_tasks();
-  #endif
-
-	//lcd_update();
-  host_keepalive();
+#if ENABLED(ADVANCED_PAUSE_FEATURE) && DISABLED(LGT_MAC)
+  static bool idle_no_stepper_sleep; // = false
+#endif
 
+static void idle_manage_inactivity() {
   manage_inactivity(
-#ifdef LGT_MAC
-	  LGT_is_printing
-#elif ENABLED(ADVANCED_PAUSE_FEATURE)
-      no_stepper_sleep
-#endif //LGT_MAC
+    #ifdef LGT_MAC
+      LGT_is_printing
+    #elif ENABLED(ADVANCED_PAUSE_FEATURE)
+      idle_no_stepper_sleep
+    #endif
   );
+}
+
+static void idle_manage_heater() { thermalManager.manage_heater(); }
+
+#if ENABLED(MAX7219_DEBUG)
+  static void idle_max7219() { max7219.idle_tasks(); }
+#endif
+#if ENABLED(HOST_KEEPALIVE_FEATURE)
+  static void idle_host_keepalive() { host_keepalive(); }
+#endif
+#if ENABLED(PRINTCOUNTER)
+  static void idle_print_job_timer() { print_job_timer.tick(); }
+#endif
+#if HAS_BUZZER && DISABLED(LCD_USE_I2C_BUZZER)
+  static void idle_buzzer() { buzzer.tick(); }
+#endif
+#if ENABLED(I2C_POSITION_ENCODERS)
+  static void idle_i2cpem() { if (planner.has_blocks_queued()) I2CPEM.update(); }
+#endif
 
-  thermalManager.manage_heater();
+#if HAS_AUTO_REPORTING
+  static void idle_auto_report() {
+    if (suspend_auto_report) return;
+    #if ENABLED(AUTO_REPORT_TEMPERATURES)
+      thermalManager.auto_report_temperatures();
+    #endif
+    #if ENABLED(AUTO_REPORT_SD_STATUS)
+      card.auto_report_sd_status();
+    #endif
+  }
+#endif
+
+#define IDLE_TASK(F, PERIOD, BUDGET, REENTRANT) { F, PERIOD, BUDGET, REENTRANT, #F }
 
+static const idle_task_t idle_task_table[] PROGMEM = {
+  #if ENABLED(MAX7219_DEBUG)
+    IDLE_TASK(idle_max7219,             0, 1000, true),
+  #endif
+  #if ENABLED(HOST_KEEPALIVE_FEATURE)
+    IDLE_TASK(idle_host_keepalive,    100,  500, true),
+  #endif
+  IDLE_TASK(idle_manage_inactivity,     0, 2000, true),
+  IDLE_TASK(idle_manage_heater,         0, 1000, true),
   #if ENABLED(PRINTCOUNTER)
-    print_job_timer.tick();
+    IDLE_TASK(idle_print_job_timer,   100, 1000, true),
   #endif
-
   #if HAS_BUZZER && DISABLED(LCD_USE_I2C_BUZZER)
-    buzzer.tick();
+    IDLE_TASK(idle_buzzer,              0,  100, true),
   #endif
-
   #if ENABLED(I2C_POSITION_ENCODERS)
-    static millis_t i2cpem_next_update_ms;
-    if (planner.has_blocks_queued() && ELAPSED(millis(), i2cpem_next_update_ms)) {
-      I2CPEM.update();
-      i2cpem_next_update_ms = millis() + I2CPE_MIN_UPD_TIME_MS;
-    }
+    IDLE_TASK(idle_i2cpem, I2CPE_MIN_UPD_TIME_MS, 2000, false),
   #endif
-
   #if HAS_AUTO_REPORTING
-    if (!suspend_auto_report) {
-      #if ENABLED(AUTO_REPORT_TEMPERATURES)
-        thermalManager.auto_report_temperatures();
-      #endif
-      #if ENABLED(AUTO_REPORT_SD_STATUS)
-        card.auto_report_sd_status();
-      #endif
-    }
+    IDLE_TASK(idle_auto_report,         0, 2000, true),
   #endif
-#ifdef LGT_MAC
-	DWIN_MAIN_FUNCTIONS();
-#endif // LGT_MAC
+  #ifdef LGT_MAC
+    // The screen handler waits on the planner and calls idle() itself
+    IDLE_TASK(DWIN_MAIN_FUNCTIONS,      0, 4000, false),
+  #endif
+};
+
+static_assert(COUNT(idle_task_table) <= IDLE_TASKS_MAX, "Too many idle tasks. Raise IDLE_TASKS_MAX.");
+
+static idle_task_state_t idle_task_state[COUNT(idle_task_table)];
+
+#if ENABLED(IDLE_TASK_STATS)
+  /**
+   * M2011: Report idle task overruns and runtime histograms
+   *
+   *   R - Reset the statistics after reporting
+   */
+  void gcode_M2011() {
+    idle_tasks.report(idle_task_table, idle_task_state, COUNT(idle_task_table), parser.seen('R'));
+  }
+#endif
+
+/**
+ * Standard idle routine keeps the machine alive
+ */
+void idle(
+  #if ENABLED(ADVANCED_PAUSE_FEATURE)
+    bool no_stepper_sleep/*=false*/
+  #endif
+) {
+  #if ENABLED(ADVANCED_PAUSE_FEATURE) && DISABLED(LGT_MAC)
+    idle_no_stepper_sleep = no_stepper_sleep;
+  #endif
+
+  idle_tasks.run(idle_task_table, idle_task_state, COUNT(idle_task_table));
 }
 
 /**
@@ -15396,9 +15803,6 @@ void setup() {
   SERIAL_ECHOPAIR(MSG_FREE_MEMORY, freeMemory());
   SERIAL_ECHOLNPAIR(MSG_PLANNER_BUFFER_BYTES, int(sizeof(block_t))*(BLOCK_BUFFER_SIZE));
 
-  // Send "ok" after commands by default
-  for (int8_t i = 0; i < BUFSIZE; i++) send_ok[i] = true;
-
   // Load data from EEPROM if available (or use defaults)
   // This also updates variables in the planner, elsewhere
   (void)settings.load();
@@ -15603,14 +16007,14 @@ void loop() {
     card.checkautostart();
   #endif // SDSUPPORT
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (next_command_slot() >= 0) get_available_commands();
 
   if (commands_in_queue) {
 
     #if ENABLED(SDSUPPORT)
 
       if (card.saving) {
-        char* command = command_queue[cmd_queue_index_r];
+        char* command = QUEUED_CMD(cmd_queue_index_r);
         if (strstr_P(command, PSTR("M29"))) {
           // M29 closes the file
           card.closefile();
@@ -15654,7 +16058,11 @@ void loop() {
     // The queue may be reset by a command handler or by code invoked by idle() within a handler
     if (commands_in_queue) {
       --commands_in_queue;
-      if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
+      cmd_queue_index_r += QUEUED(cmd_queue_index_r)->size;
+      if (cmd_queue_index_r >= cmd_queue_end) {
+        cmd_queue_index_r = 0;
+        cmd_queue_end = COMMAND_QUEUE_SIZE;
+      }
     }
   }
   endstops.event_handler();
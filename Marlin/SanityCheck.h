@@ -421,6 +421,18 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #error "Graphical LCD is required for SHOW_CUSTOM_BOOTSCREEN and CUSTOM_STATUS_SCREEN_IMAGE."
 #endif
 
+/**
+ * SD read buffer and block cache
+ */
+#if ENABLED(SDSUPPORT)
+  #if SD_READ_BUFFER_SIZE < 16 || SD_READ_BUFFER_SIZE > 512 || (SD_READ_BUFFER_SIZE & (SD_READ_BUFFER_SIZE - 1))
+    #error "SD_READ_BUFFER_SIZE must be a power of 2 from 16 to 512."
+  #endif
+  #if !defined(SD_CACHE_SLOTS) || !WITHIN(SD_CACHE_SLOTS, 1, 4)
+    #error "SD_CACHE_SLOTS must be from 1 to 4."
+  #endif
+#endif
+
 /**
  * SD File Sorting
  */
@@ -496,6 +508,8 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
     #error "FILAMENT_RUNOUT_SENSOR with NUM_RUNOUT_SENSORS > 3 requires FIL_RUNOUT4_PIN."
   #elif NUM_RUNOUT_SENSORS > 4 && !PIN_EXISTS(FIL_RUNOUT5)
     #error "FILAMENT_RUNOUT_SENSOR with NUM_RUNOUT_SENSORS > 4 requires FIL_RUNOUT5_PIN."
+  #elif !defined(FIL_RUNOUT_DEBOUNCE)
+    #error "FILAMENT_RUNOUT_SENSOR requires FIL_RUNOUT_DEBOUNCE."
   #elif DISABLED(SDSUPPORT) && DISABLED(PRINTJOB_TIMER_AUTOSTART)
     #error "FILAMENT_RUNOUT_SENSOR requires SDSUPPORT or PRINTJOB_TIMER_AUTOSTART."
   #elif DISABLED(ADVANCED_PAUSE_FEATURE)
@@ -608,6 +622,30 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #endif
 #endif
 
+/**
+ * Step Interval Ramps
+ */
+#if ENABLED(STEP_INTERVAL_RAMPS)
+  #if ENABLED(S_CURVE_ACCELERATION)
+    #error "STEP_INTERVAL_RAMPS is incompatible with S_CURVE_ACCELERATION."
+  #elif ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    #error "STEP_INTERVAL_RAMPS is incompatible with ADAPTIVE_STEP_SMOOTHING."
+  #elif !WITHIN(STEP_RAMP_MIN_STEPS, 8, 1000)
+    #error "STEP_RAMP_MIN_STEPS must be a value from 8 to 1000."
+  #endif
+#endif
+
+/**
+ * Stepper ISR Governor
+ */
+#if ENABLED(STEP_ISR_GOVERNOR)
+  #if !(0 < STEP_GOVERNOR_LOAD_LOW && STEP_GOVERNOR_LOAD_LOW < STEP_GOVERNOR_LOAD_TARGET && STEP_GOVERNOR_LOAD_TARGET < STEP_GOVERNOR_LOAD_HIGH && STEP_GOVERNOR_LOAD_HIGH < 100)
+    #error "STEP_ISR_GOVERNOR requires 0 < STEP_GOVERNOR_LOAD_LOW < STEP_GOVERNOR_LOAD_TARGET < STEP_GOVERNOR_LOAD_HIGH < 100."
+  #elif STEP_GOVERNOR_MIN_RATE < 1000
+    #error "STEP_GOVERNOR_MIN_RATE must be at least 1000."
+  #endif
+#endif
+
 /**
  * Linear Advance 1.5 - Check K value range
  */
@@ -680,6 +718,10 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
 /**
  * Bed Heating Options - PID vs Limit Switching
  */
+#if ENABLED(PID_FIXED_POINT) && ENABLED(PID_EXTRUSION_SCALING)
+  #error "PID_FIXED_POINT does not support PID_EXTRUSION_SCALING."
+#endif
+
 #if ENABLED(PIDTEMPBED) && ENABLED(BED_LIMIT_SWITCHING)
   #error "To use BED_LIMIT_SWITCHING you must disable PIDTEMPBED."
 #endif
@@ -1530,6 +1572,13 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #error "select hardware UART for TMC2208 to use both TMC2208 and ENDSTOP_INTERRUPTS_FEATURE."
 #endif
 
+/**
+ * Faster first approach to interrupt-driven endstops
+ */
+#if ENABLED(ENDSTOP_INTERRUPTS_FEATURE) && defined(HOMING_FAST_APPROACH)
+  static_assert(HOMING_FAST_APPROACH >= 1, "HOMING_FAST_APPROACH must be 1 or more.");
+#endif
+
 #if ENABLED(SENSORLESS_HOMING)
   // Require STEALTHCHOP for SENSORLESS_HOMING on DELTA as the transition from spreadCycle to stealthChop
   // is necessary in order to reset the stallGuard indication between the initial movement of all three
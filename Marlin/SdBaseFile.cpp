@@ -64,14 +64,15 @@ bool SdBaseFile::addDirCluster() {
   block = vol_->clusterStartBlock(curCluster_);
 
   // set cache to first block of cluster
-  vol_->cacheSetBlockNumber(block, true);
+  if (!vol_->cacheSetBlockNumber(block, true, SdVolume::CACHE_PURPOSE_DIR)) return false;
 
   // zero first block of cluster
-  memset(vol_->cacheBuffer_.data, 0, 512);
+  memset(vol_->cache()->data, 0, 512);
 
   // zero rest of cluster
   for (uint8_t i = 1; i < vol_->blocksPerCluster_; i++) {
-    if (!vol_->writeBlock(block + i, vol_->cacheBuffer_.data)) return false;
+    vol_->cacheInvalidate(block + i);
+    if (!vol_->writeBlock(block + i, vol_->cache()->data)) return false;
   }
   // Increase directory file size by cluster size
   fileSize_ += 512UL << vol_->clusterSizeShift_;
@@ -81,7 +82,7 @@ bool SdBaseFile::addDirCluster() {
 // cache a file's directory entry
 // return pointer to cached entry or null for failure
 dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
-  if (!vol_->cacheRawBlock(dirBlock_, action)) return NULL;
+  if (!vol_->cacheRawBlock(dirBlock_, action, SdVolume::CACHE_PURPOSE_DIR)) return NULL;
   return vol_->cache()->dir + dirIndex_;
 }
 
@@ -476,7 +477,7 @@ bool SdBaseFile::mkdir(SdBaseFile* parent, const uint8_t dname[11]) {
 
   // cache block for '.'  and '..'
   block = vol_->clusterStartBlock(firstCluster_);
-  if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE)) return false;
+  if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE, SdVolume::CACHE_PURPOSE_DIR)) return false;
 
   // copy '.' to block
   memcpy(&vol_->cache()->dir[0], &d, sizeof(d));
@@ -827,9 +828,9 @@ bool SdBaseFile::openParent(SdBaseFile* dir) {
   // start block for '..'
   lbn = vol_->clusterStartBlock(cluster);
   // first block of parent dir
-  if (!vol_->cacheRawBlock(lbn, SdVolume::CACHE_FOR_READ)) return false;
+  if (!vol_->cacheRawBlock(lbn, SdVolume::CACHE_FOR_READ, SdVolume::CACHE_PURPOSE_DIR)) return false;
 
-  p = &vol_->cacheBuffer_.dir[1];
+  p = &vol_->cache()->dir[1];
   // verify name for '../..'
   if (p->name[0] != '.' || p->name[1] != '.') return false;
   // '..' is pointer to first cluster of parent. open '../..' to find parent
@@ -1022,12 +1023,12 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
     NOMORE(n, 512 - offset);
 
     // no buffering needed if n == 512
-    if (n == 512 && block != vol_->cacheBlockNumber()) {
+    if (n == 512 && vol_->cacheFind(block) < 0) {
       if (!vol_->readBlock(block, dst)) return -1;
     }
     else {
       // read block to cache and copy data to caller
-      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return -1;
+      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ, isDir() ? SdVolume::CACHE_PURPOSE_DIR : SdVolume::CACHE_PURPOSE_DATA)) return -1;
       uint8_t* src = vol_->cache()->data + offset;
       memcpy(dst, src, n);
     }
@@ -1235,7 +1236,7 @@ bool SdBaseFile::rename(SdBaseFile* dirFile, const char* newPath) {
   if (dirCluster) {
     // get new dot dot
     uint32_t block = vol_->clusterStartBlock(dirCluster);
-    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return false;
+    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ, SdVolume::CACHE_PURPOSE_DIR)) return false;
     memcpy(&entry, &vol_->cache()->dir[1], sizeof(entry));
 
     // free unused cluster
@@ -1243,7 +1244,7 @@ bool SdBaseFile::rename(SdBaseFile* dirFile, const char* newPath) {
 
     // store new dot dot
     block = vol_->clusterStartBlock(firstCluster_);
-    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE)) return false;
+    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE, SdVolume::CACHE_PURPOSE_DIR)) return false;
     memcpy(&vol_->cache()->dir[1], &entry, sizeof(entry));
   }
   return vol_->cacheFlush();
@@ -1680,10 +1681,8 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
     if (n == 512) {
       // full block - don't need to use cache
-      if (vol_->cacheBlockNumber() == block) {
-        // invalidate cache if block is in cache
-        vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
-      }
+      // invalidate cache if block is in cache
+      vol_->cacheInvalidate(block);
       if (!vol_->writeBlock(block, src)) goto FAIL;
     }
     else {
@@ -1691,7 +1690,7 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
         // start of new block don't need to read into cache
         if (!vol_->cacheFlush()) goto FAIL;
         // set cache dirty and SD address of block
-        vol_->cacheSetBlockNumber(block, true);
+        if (!vol_->cacheSetBlockNumber(block, true)) goto FAIL;
       }
       else {
         // rewrite part of block
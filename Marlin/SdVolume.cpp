@@ -34,11 +34,15 @@
 
 #if !USE_MULTIPLE_CARDS
   // raw block cache
-  uint32_t SdVolume::cacheBlockNumber_;  // current block number
-  cache_t  SdVolume::cacheBuffer_;       // 512 byte cache for Sd2Card
-  Sd2Card* SdVolume::sdCard_;            // pointer to SD card object
-  bool     SdVolume::cacheDirty_;        // cacheFlush() will write block if true
-  uint32_t SdVolume::cacheMirrorBlock_;  // mirror  block for second FAT
+  cache_t  SdVolume::cacheBuffer_[SD_CACHE_SLOTS];   // 512 byte caches for Sd2Card
+  uint32_t SdVolume::cacheBlock_[SD_CACHE_SLOTS];    // block number in each slot
+  uint32_t SdVolume::cacheMirror_[SD_CACHE_SLOTS];   // mirror block for second FAT
+  bool     SdVolume::cacheDirty_[SD_CACHE_SLOTS];    // cacheFlush() will write block if true
+  uint8_t  SdVolume::cachePurpose_[SD_CACHE_SLOTS];  // what each slot is holding
+  uint8_t  SdVolume::cacheAge_[SD_CACHE_SLOTS];      // accesses since each slot was used
+  uint8_t  SdVolume::cacheSlot_;                     // current slot
+  Sd2Card* SdVolume::sdCard_;                        // pointer to SD card object
+  uint32_t SdVolume::cacheHits_, SdVolume::cacheMisses_, SdVolume::cacheDirectReads_;
 #endif  // USE_MULTIPLE_CARDS
 
 // find a contiguous group of clusters
@@ -113,32 +117,96 @@ bool SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
   return true;
 }
 
-bool SdVolume::cacheFlush() {
-  if (cacheDirty_) {
-    if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data))
+bool SdVolume::cacheFlushSlot(uint8_t slot) {
+  if (cacheDirty_[slot]) {
+    if (!sdCard_->writeBlock(cacheBlock_[slot], cacheBuffer_[slot].data))
       return false;
 
     // mirror FAT tables
-    if (cacheMirrorBlock_) {
-      if (!sdCard_->writeBlock(cacheMirrorBlock_, cacheBuffer_.data))
+    if (cacheMirror_[slot]) {
+      if (!sdCard_->writeBlock(cacheMirror_[slot], cacheBuffer_[slot].data))
         return false;
-      cacheMirrorBlock_ = 0;
+      cacheMirror_[slot] = 0;
     }
-    cacheDirty_ = 0;
+    cacheDirty_[slot] = 0;
   }
   return true;
 }
 
-bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty) {
-  if (cacheBlockNumber_ != blockNumber) {
-    if (!cacheFlush()) return false;
-    if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) return false;
-    cacheBlockNumber_ = blockNumber;
+bool SdVolume::cacheFlush() {
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++)
+    if (!cacheFlushSlot(i)) return false;
+  return true;
+}
+
+// slot holding a block, or -1. The current slot is the likeliest.
+int8_t SdVolume::cacheFind(uint32_t blockNumber) {
+  if (cacheBlock_[cacheSlot_] == blockNumber) return cacheSlot_;
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++)
+    if (cacheBlock_[i] == blockNumber) return i;
+  return -1;
+}
+
+// slot to replace: an empty one, else the least recently
+// used of the same purpose, else the least recently used
+uint8_t SdVolume::cacheVictim(uint8_t purpose) {
+  int8_t own = -1;
+  uint8_t any = 0;
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++) {
+    if (cacheBlock_[i] == 0xFFFFFFFF) return i;
+    if (cachePurpose_[i] == purpose && (own < 0 || cacheAge_[i] > cacheAge_[own])) own = i;
+    if (cacheAge_[i] > cacheAge_[any]) any = i;
   }
-  if (dirty) cacheDirty_ = true;
+  return own >= 0 ? own : any;
+}
+
+// make a slot current and most recently used
+void SdVolume::cacheUse(uint8_t slot, uint8_t purpose) {
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++)
+    if (cacheAge_[i] < 0xFF) cacheAge_[i]++;
+  cacheAge_[slot] = 0;
+  cachePurpose_[slot] = purpose;
+  cacheSlot_ = slot;
+}
+
+bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty, uint8_t purpose/*=CACHE_PURPOSE_DATA*/) {
+  int8_t slot = cacheFind(blockNumber);
+  if (slot >= 0)
+    cacheHits_++;
+  else {
+    slot = cacheVictim(purpose);
+    if (!cacheFlushSlot(slot)) return false;
+    cacheBlock_[slot] = 0xFFFFFFFF;
+    if (!sdCard_->readBlock(blockNumber, cacheBuffer_[slot].data)) return false;
+    cacheBlock_[slot] = blockNumber;
+    cacheMisses_++;
+  }
+  cacheUse(slot, purpose);
+  if (dirty) cacheDirty_[slot] = true;
+  return true;
+}
+
+// used by SdBaseFile write to assign a slot to SD location without reading it
+bool SdVolume::cacheSetBlockNumber(uint32_t blockNumber, bool dirty, uint8_t purpose/*=CACHE_PURPOSE_DATA*/) {
+  cacheInvalidate(blockNumber);
+  const uint8_t slot = cacheVictim(purpose);
+  if (!cacheFlushSlot(slot)) return false;
+  cacheBlock_[slot] = blockNumber;
+  cacheDirty_[slot] = dirty;
+  cacheUse(slot, purpose);
   return true;
 }
 
+// drop a block from the cache without writing it
+void SdVolume::cacheInvalidate(uint32_t blockNumber) {
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++)
+    if (cacheBlock_[i] == blockNumber) {
+      cacheBlock_[i] = 0xFFFFFFFF;
+      cacheDirty_[i] = false;
+      cacheMirror_[i] = 0;
+    }
+}
+
 // return the size in bytes of a cluster chain
 bool SdVolume::chainSize(uint32_t cluster, uint32_t* size) {
   uint32_t s = 0;
@@ -158,15 +226,15 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
     uint16_t index = cluster;
     index += index >> 1;
     lba = fatStartBlock_ + (index >> 9);
-    if (!cacheRawBlock(lba, CACHE_FOR_READ)) return false;
+    if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return false;
     index &= 0x1FF;
-    uint16_t tmp = cacheBuffer_.data[index];
+    uint16_t tmp = cache()->data[index];
     index++;
     if (index == 512) {
-      if (!cacheRawBlock(lba + 1, CACHE_FOR_READ)) return false;
+      if (!cacheRawBlock(lba + 1, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return false;
       index = 0;
     }
-    tmp |= cacheBuffer_.data[index] << 8;
+    tmp |= cache()->data[index] << 8;
     *value = cluster & 1 ? tmp >> 4 : tmp & 0xFFF;
     return true;
   }
@@ -178,10 +246,9 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
   else
     return false;
 
-  if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
-    return false;
+  if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return false;
 
-  *value = (fatType_ == 16) ? cacheBuffer_.fat16[cluster & 0xFF] : (cacheBuffer_.fat32[cluster & 0x7F] & FAT32MASK);
+  *value = (fatType_ == 16) ? cache()->fat16[cluster & 0xFF] : (cache()->fat32[cluster & 0x7F] & FAT32MASK);
   return true;
 }
 
@@ -198,28 +265,28 @@ bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
     uint16_t index = cluster;
     index += index >> 1;
     lba = fatStartBlock_ + (index >> 9);
-    if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+    if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PURPOSE_FAT)) return false;
     // mirror second FAT
-    if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+    if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
     index &= 0x1FF;
     uint8_t tmp = value;
     if (cluster & 1) {
-      tmp = (cacheBuffer_.data[index] & 0xF) | tmp << 4;
+      tmp = (cache()->data[index] & 0xF) | tmp << 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     index++;
     if (index == 512) {
       lba++;
       index = 0;
-      if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+      if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PURPOSE_FAT)) return false;
       // mirror second FAT
-      if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+      if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
     }
     tmp = value >> 4;
     if (!(cluster & 1)) {
-      tmp = ((cacheBuffer_.data[index] & 0xF0)) | tmp >> 4;
+      tmp = ((cache()->data[index] & 0xF0)) | tmp >> 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     return true;
   }
 
@@ -230,16 +297,16 @@ bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
   else
     return false;
 
-  if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
+  if (!cacheRawBlock(lba, CACHE_FOR_WRITE, CACHE_PURPOSE_FAT)) return false;
 
   // store entry
   if (fatType_ == 16)
-    cacheBuffer_.fat16[cluster & 0xFF] = value;
+    cache()->fat16[cluster & 0xFF] = value;
   else
-    cacheBuffer_.fat32[cluster & 0x7F] = value;
+    cache()->fat32[cluster & 0x7F] = value;
 
   // mirror second FAT
-  if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+  if (fatCount_ > 1) cacheSetMirror(lba + blocksPerFat_);
   return true;
 }
 
@@ -278,15 +345,15 @@ int32_t SdVolume::freeClusterCount() {
     return -1;
 
   for (uint32_t lba = fatStartBlock_; todo; todo -= n, lba++) {
-    if (!cacheRawBlock(lba, CACHE_FOR_READ)) return -1;
+    if (!cacheRawBlock(lba, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return -1;
     NOMORE(n, todo);
     if (fatType_ == 16) {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat16[i] == 0) free++;
+        if (cache()->fat16[i] == 0) free++;
     }
     else {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat32[i] == 0) free++;
+        if (cache()->fat32[i] == 0) free++;
     }
   }
   return free;
@@ -312,22 +379,25 @@ bool SdVolume::init(Sd2Card* dev, uint8_t part) {
   sdCard_ = dev;
   fatType_ = 0;
   allocSearchStart_ = 2;
-  cacheDirty_ = 0;  // cacheFlush() will write block if true
-  cacheMirrorBlock_ = 0;
-  cacheBlockNumber_ = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < SD_CACHE_SLOTS; i++) {
+    cacheDirty_[i] = 0;  // cacheFlush() will write block if true
+    cacheMirror_[i] = 0;
+    cacheBlock_[i] = 0xFFFFFFFF;
+  }
+  cacheSlot_ = 0;
 
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
     if (part > 4) return false;
-    if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-    part_t* p = &cacheBuffer_.mbr.part[part - 1];
+    if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return false;
+    part_t* p = &cache()->mbr.part[part - 1];
     if ((p->boot & 0x7F) != 0  || p->totalSectors < 100 || p->firstSector == 0)
       return false; // not a valid partition
     volumeStartBlock = p->firstSector;
   }
-  if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-  fbs = &cacheBuffer_.fbs32;
+  if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ, CACHE_PURPOSE_FAT)) return false;
+  fbs = &cache()->fbs32;
   if (fbs->bytesPerSector != 512 ||
       fbs->fatCount == 0 ||
       fbs->reservedSectorCount == 0 ||
@@ -69,8 +69,8 @@ class SdVolume {
    */
   cache_t* cacheClear() {
     if (!cacheFlush()) return 0;
-    cacheBlockNumber_ = 0xFFFFFFFF;
-    return &cacheBuffer_;
+    cacheBlock_[cacheSlot_] = 0xFFFFFFFF;
+    return cache();
   }
 
   /**
@@ -119,6 +119,15 @@ class SdVolume {
    */
   bool dbgFat(uint32_t n, uint32_t* v) { return fatGet(n, v); }
 
+  /**
+   * Block cache statistics: lookups served from a cache slot, lookups
+   * that had to read the card, and whole blocks read past the cache.
+   */
+  uint32_t cacheHits() const { return cacheHits_; }
+  uint32_t cacheMisses() const { return cacheMisses_; }
+  uint32_t cacheDirectReads() const { return cacheDirectReads_; }
+  void cacheResetStats() { cacheHits_ = cacheMisses_ = cacheDirectReads_ = 0; }
+
  private:
   // Allow SdBaseFile access to SdVolume private data.
   friend class SdBaseFile;
@@ -128,18 +137,32 @@ class SdVolume {
   // value for dirty argument in cacheRawBlock to indicate write to cache
   static bool const CACHE_FOR_WRITE = true;
 
+  // purpose tags for cacheRawBlock. A block is only allowed to evict a slot
+  // of another purpose when no slot of its own purpose is free or in use.
+  static uint8_t const CACHE_PURPOSE_DATA = 0;  // file data
+  static uint8_t const CACHE_PURPOSE_FAT  = 1;  // FAT and boot sectors
+  static uint8_t const CACHE_PURPOSE_DIR  = 2;  // directory entries
+
   #if USE_MULTIPLE_CARDS
-    cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    uint32_t cacheBlockNumber_;  // Logical number of block in the cache
-    Sd2Card* sdCard_;            // Sd2Card object for cache
-    bool cacheDirty_;            // cacheFlush() will write block if true
-    uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    cache_t cacheBuffer_[SD_CACHE_SLOTS];          // 512 byte caches for device blocks
+    uint32_t cacheBlock_[SD_CACHE_SLOTS];          // Logical number of block in each slot
+    uint32_t cacheMirror_[SD_CACHE_SLOTS];         // block number for mirror FAT
+    bool cacheDirty_[SD_CACHE_SLOTS];              // cacheFlush() will write block if true
+    uint8_t cachePurpose_[SD_CACHE_SLOTS];         // what each slot is holding
+    uint8_t cacheAge_[SD_CACHE_SLOTS];             // accesses since each slot was used
+    uint8_t cacheSlot_;                            // slot returned by cache()
+    Sd2Card* sdCard_;                              // Sd2Card object for cache
+    uint32_t cacheHits_, cacheMisses_, cacheDirectReads_;
   #else
-    static cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    static uint32_t cacheBlockNumber_;  // Logical number of block in the cache
-    static Sd2Card* sdCard_;            // Sd2Card object for cache
-    static bool cacheDirty_;            // cacheFlush() will write block if true
-    static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    static cache_t cacheBuffer_[SD_CACHE_SLOTS];   // 512 byte caches for device blocks
+    static uint32_t cacheBlock_[SD_CACHE_SLOTS];   // Logical number of block in each slot
+    static uint32_t cacheMirror_[SD_CACHE_SLOTS];  // block number for mirror FAT
+    static bool cacheDirty_[SD_CACHE_SLOTS];       // cacheFlush() will write block if true
+    static uint8_t cachePurpose_[SD_CACHE_SLOTS];  // what each slot is holding
+    static uint8_t cacheAge_[SD_CACHE_SLOTS];      // accesses since each slot was used
+    static uint8_t cacheSlot_;                     // slot returned by cache()
+    static Sd2Card* sdCard_;                       // Sd2Card object for cache
+    static uint32_t cacheHits_, cacheMisses_, cacheDirectReads_;
   #endif
 
   uint32_t allocSearchStart_;   // start cluster for alloc search
@@ -159,23 +182,32 @@ class SdVolume {
   uint32_t clusterStartBlock(uint32_t cluster) const { return dataStartBlock_ + ((cluster - 2) << clusterSizeShift_); }
   uint32_t blockNumber(uint32_t cluster, uint32_t position) const { return clusterStartBlock(cluster) + blockOfCluster(position); }
 
-  cache_t* cache() { return &cacheBuffer_; }
-  uint32_t cacheBlockNumber() const { return cacheBlockNumber_; }
+  // the slot most recently returned by cacheRawBlock or cacheSetBlockNumber
+  cache_t* cache() { return &cacheBuffer_[cacheSlot_]; }
+  uint32_t cacheBlockNumber() const { return cacheBlock_[cacheSlot_]; }
 
   #if USE_MULTIPLE_CARDS
     bool cacheFlush();
-    bool cacheRawBlock(uint32_t blockNumber, bool dirty);
+    bool cacheFlushSlot(uint8_t slot);
+    int8_t cacheFind(uint32_t blockNumber);
+    uint8_t cacheVictim(uint8_t purpose);
+    void cacheUse(uint8_t slot, uint8_t purpose);
+    bool cacheRawBlock(uint32_t blockNumber, bool dirty, uint8_t purpose=CACHE_PURPOSE_DATA);
+    bool cacheSetBlockNumber(uint32_t blockNumber, bool dirty, uint8_t purpose=CACHE_PURPOSE_DATA);
+    void cacheInvalidate(uint32_t blockNumber);
   #else
     static bool cacheFlush();
-    static bool cacheRawBlock(uint32_t blockNumber, bool dirty);
+    static bool cacheFlushSlot(uint8_t slot);
+    static int8_t cacheFind(uint32_t blockNumber);
+    static uint8_t cacheVictim(uint8_t purpose);
+    static void cacheUse(uint8_t slot, uint8_t purpose);
+    static bool cacheRawBlock(uint32_t blockNumber, bool dirty, uint8_t purpose=CACHE_PURPOSE_DATA);
+    static bool cacheSetBlockNumber(uint32_t blockNumber, bool dirty, uint8_t purpose=CACHE_PURPOSE_DATA);
+    static void cacheInvalidate(uint32_t blockNumber);
   #endif
 
-  // used by SdBaseFile write to assign cache to SD location
-  void cacheSetBlockNumber(uint32_t blockNumber, bool dirty) {
-    cacheDirty_ = dirty;
-    cacheBlockNumber_  = blockNumber;
-  }
-  void cacheSetDirty() { cacheDirty_ |= CACHE_FOR_WRITE; }
+  void cacheSetDirty() { cacheDirty_[cacheSlot_] |= CACHE_FOR_WRITE; }
+  void cacheSetMirror(uint32_t blockNumber) { cacheMirror_[cacheSlot_] = blockNumber; }
   bool chainSize(uint32_t beginCluster, uint32_t* size);
   bool fatGet(uint32_t cluster, uint32_t* value);
   bool fatPut(uint32_t cluster, uint32_t value);
@@ -186,7 +218,7 @@ class SdVolume {
     if (fatType_ == 16) return cluster >= FAT16EOC_MIN;
     return  cluster >= FAT32EOC_MIN;
   }
-  bool readBlock(uint32_t block, uint8_t* dst) { return sdCard_->readBlock(block, dst); }
+  bool readBlock(uint32_t block, uint8_t* dst) { cacheDirectReads_++; return sdCard_->readBlock(block, dst); }
   bool writeBlock(uint32_t block, const uint8_t* dst) { return sdCard_->writeBlock(block, dst); }
 
   // Deprecated functions
@@ -59,11 +59,17 @@ CardReader::CardReader() {
   sdprinting = cardOK = saving = logging = false;
   filesize = 0;
   sdpos = 0;
+  read_pos = read_len = 0;
   file_subcall_ctr = 0;
 
   workDirDepth = 0;
   ZERO(workDirParents);
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    jobRecoveryBlock = jobRecoveryJob = jobRecoverySequence = 0;
+    jobRecoveryHeaderSaved = false;
+  #endif
+
   // Disable autostart until card is initialized
   autostart_index = -1;
 
@@ -266,6 +272,9 @@ void CardReader::printFilename() {
 
 void CardReader::initsd() {
   cardOK = false;
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    jobRecoveryBlock = 0;
+  #endif
   if (root.isOpen()) root.close();
 
   #ifndef SPI_SPEED
@@ -300,6 +309,9 @@ void CardReader::initsd() {
 void CardReader::release() {
   sdprinting = false;
   cardOK = false;
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    jobRecoveryBlock = 0;
+  #endif
 }
 
 void CardReader::openAndPrintFile(const char *name) {
@@ -313,6 +325,9 @@ void CardReader::openAndPrintFile(const char *name) {
 void CardReader::startFileprint() {
   if (cardOK) {
     sdprinting = true;
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      openJobRecoveryFile(); // Allocate the journal now, not at the first layer
+    #endif
     #if SD_RESORT
       flush_presort();
     #endif
@@ -416,6 +431,10 @@ void CardReader::openFile(char * const path, const bool read, const bool subcall
     if (file.open(curDir, fname, O_READ)) {
       filesize = file.fileSize();
       sdpos = 0;
+      read_pos = read_len = 0;
+      #if ENABLED(POWER_LOSS_RECOVERY)
+        jobRecoveryHeaderSaved = false;
+      #endif
       SERIAL_PROTOCOLPAIR(MSG_SD_FILE_OPENED, fname);
       SERIAL_PROTOCOLLNPAIR(MSG_SD_SIZE, filesize);
       SERIAL_PROTOCOLLNPGM(MSG_SD_FILE_SELECTED);
@@ -481,6 +500,14 @@ void CardReader::getStatus() {
     SERIAL_PROTOCOLLNPGM(MSG_SD_NOT_PRINTING);
 }
 
+void CardReader::reportCacheStats(const bool reset) {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("SD cache hits: ", volume.cacheHits());
+  SERIAL_ECHOPAIR(" misses: ", volume.cacheMisses());
+  SERIAL_ECHOLNPAIR(" direct reads: ", volume.cacheDirectReads());
+  if (reset) volume.cacheResetStats();
+}
+
 void CardReader::write_command(char *buf) {
   char* begin = buf;
   char* npos = NULL;
@@ -901,6 +928,104 @@ uint16_t CardReader::get_num_Files() {
   ;
 }
 
+#ifdef LGT_MAC
+
+  /**
+   * Index the G-code files of the working directory in a single forward
+   * pass, for the touchscreen file list. The directory entry index of the
+   * last 'max' files found is stored, newest (last in the directory) first,
+   * so getfilename_at() can fetch a name without rescanning the directory.
+   * Returns the number of entries stored.
+   */
+  uint16_t CardReader::index_gcode_files(uint16_t * const dir_index, const uint16_t max) {
+    dir_t p;
+    uint16_t found = 0, slot = 0;
+    workDir.rewind();
+    for (;;) {
+      const uint32_t pos = workDir.curPosition();  // LFN entries start here
+      if (workDir.readDir(&p, longFilename) <= 0) break;
+      if (longFilename[0] == '.') continue;
+      if (!DIR_IS_FILE(&p) || (p.attributes & DIR_ATT_HIDDEN)) continue;
+      if (p.name[8] != 'G' || p.name[9] == '~') continue;
+      dir_index[slot] = pos >> 5;                  // kept as a ring of the last 'max'
+      if (++slot >= max) slot = 0;
+      found++;
+    }
+
+    if (!found) return 0;
+
+    // Unroll the ring, newest first
+    const uint16_t count = min(found, max);
+    uint16_t ordered[count];
+    for (uint16_t i = 0; i < count; i++) {
+      slot = slot ? slot - 1 : max - 1;
+      ordered[i] = dir_index[slot];
+    }
+    memcpy(dir_index, ordered, sizeof(ordered));
+    return count;
+  }
+
+  /**
+   * Get the name of the file at a directory entry index from index_gcode_files()
+   */
+  void CardReader::getfilename_at(const uint16_t dir_index) {
+    dir_t p;
+    if (workDir.seekSet((uint32_t)dir_index << 5) && workDir.readDir(&p, longFilename) > 0) {
+      createFilename(filename, p);
+      filenameIsDir = DIR_IS_SUBDIR(&p);
+    }
+    else
+      filename[0] = longFilename[0] = '\0';
+  }
+
+#endif // LGT_MAC
+
+/**
+ * Refill the read buffer, up to the next SD_READ_BUFFER_SIZE boundary
+ * of the file so aligned reads can skip the volume cache.
+ */
+bool CardReader::fill_read_buffer() {
+  const int16_t n = file.read(read_buf, SD_READ_BUFFER_SIZE - (sdpos & (SD_READ_BUFFER_SIZE - 1)));
+  read_pos = 0;
+  read_len = n > 0 ? n : 0;
+  return n > 0;
+}
+
+/**
+ * Copy the next command from the file into dst, dropping comments and
+ * anything past max - 1 characters. A command ends at a newline, at '#'
+ * or ':' outside a comment, or at the end of the file. The character
+ * that ended it is returned in term ('\0' at the end of the file).
+ * Returns the command length, or -1 on a read error.
+ */
+int16_t CardReader::read_line(char * const dst, const uint8_t max, char &term) {
+  uint8_t count = 0;
+  bool comment = false;
+  term = '\0';
+  while (!eof()) {
+    if (read_pos >= read_len && !fill_read_buffer()) {
+      dst[count] = '\0';
+      return -1;
+    }
+    const uint16_t start = read_pos, len = read_len;
+    uint16_t pos = start;
+    while (pos < len) {
+      const char c = read_buf[pos++];
+      if (c == '\n' || c == '\r' || (!comment && (c == '#' || c == ':'))) {
+        term = c;
+        break;
+      }
+      if (c == ';') comment = true;
+      if (!comment && count < max - 1) dst[count++] = c;
+    }
+    read_pos = pos;
+    sdpos += pos - start;
+    if (term) break;
+  }
+  dst[count] = '\0';
+  return count;
+}
+
 void CardReader::printingHasFinished() {
   planner.synchronize();
   file.close();
@@ -968,30 +1093,69 @@ void CardReader::printingHasFinished() {
 
  const char job_recovery_file_name[4] = "bin";
 
+  // Each journal block is job id, sequence, data and CRC
+  static_assert(8 + JOB_RECOVERY_STATE_SIZE + 2 <= 512, "job_recovery_info_t state must fit one journal block.");
+  static_assert(8 + MAXPATHNAMELENGTH + 2 <= 512, "sd_filename must fit one journal block.");
+
+  /**
+   * Locate the journal blocks of the recovery file. Unless reading, create
+   * the file (contiguous, with empty state slots) if it is missing or is
+   * not a journal.
+   */
   void CardReader::openJobRecoveryFile(const bool read) {
     if (!cardOK) return;
-    if (jobRecoveryFile.isOpen()) return;
-    if (!jobRecoveryFile.open(&root, job_recovery_file_name, read ? O_READ : O_CREAT | O_WRITE | O_TRUNC | O_SYNC)) {
-      SERIAL_PROTOCOLPAIR(MSG_SD_OPEN_FILE_FAIL, job_recovery_file_name);
-      SERIAL_PROTOCOLCHAR('.');
-      SERIAL_EOL();
+    if (jobRecoveryBlock) return;
+    jobRecoveryHeaderSaved = false;
+
+    uint32_t bgnBlock, endBlock;
+    bool ok = false;
+    if (jobRecoveryFile.open(&root, job_recovery_file_name, O_READ)) {
+      ok = jobRecoveryFile.fileSize() >= JOB_RECOVERY_BLOCKS * 512UL
+        && jobRecoveryFile.contiguousRange(&bgnBlock, &endBlock)
+        && endBlock - bgnBlock + 1 >= JOB_RECOVERY_BLOCKS;
+      jobRecoveryFile.close();
+      if (!ok && !read) SdFile::remove(&root, job_recovery_file_name);
+    }
+    if (!ok && !read) {
+      ok = jobRecoveryFile.createContiguous(&root, job_recovery_file_name, JOB_RECOVERY_BLOCKS * 512UL)
+        && jobRecoveryFile.contiguousRange(&bgnBlock, &endBlock);
+      jobRecoveryFile.close();
+      if (ok) {
+        for (uint8_t i = 0; i < JOB_RECOVERY_BLOCKS; i++) {
+          cache_t * const c = volume.cacheClear();
+          if (!c) { ok = false; break; }
+          ZERO(c->data);
+          if (!sd2card.writeBlock(bgnBlock + i, c->data)) { ok = false; break; }
+        }
+      }
+    }
+    jobRecoveryBlock = ok ? bgnBlock : 0;
+
+    // A reused journal may not have been loaded. Continue the job ids and
+    // sequence numbers from its blocks so a stale slot can never look newer.
+    if (ok && !read) {
+      uint32_t job, sequence;
+      for (uint8_t i = 0; i < JOB_RECOVERY_BLOCKS; i++) {
+        if (!readJobRecoveryBlock(i, job, sequence, NULL, i ? JOB_RECOVERY_STATE_SIZE : MAXPATHNAMELENGTH)) continue;
+        NOLESS(jobRecoveryJob, job);
+        NOLESS(jobRecoverySequence, sequence);
+      }
+    }
+
+    if (!ok) {
+      if (!read) {
+        SERIAL_PROTOCOLPAIR(MSG_SD_OPEN_FILE_FAIL, job_recovery_file_name);
+        SERIAL_PROTOCOLCHAR('.');
+        SERIAL_EOL();
+      }
     }
     else if (!read)
       SERIAL_PROTOCOLLNPAIR(MSG_SD_WRITE_TO_FILE, job_recovery_file_name);
   }
-  void CardReader::openJobRecoveryFile() {
-	  if (!cardOK) return;
-	  if (jobRecoveryFile.isOpen()) { /*MYSERIAL0.println("return");*/ return; }
-	  if (!jobRecoveryFile.open(&root, job_recovery_file_name,O_CREAT | O_WRITE | O_TRUNC | O_SYNC)) {
-		  SERIAL_PROTOCOLPAIR(MSG_SD_OPEN_FILE_FAIL, job_recovery_file_name);
-		  SERIAL_PROTOCOLCHAR('.');
-		  SERIAL_EOL();
-	  }
-	  else
-		  SERIAL_PROTOCOLLNPAIR(MSG_SD_WRITE_TO_FILE, job_recovery_file_name);
-  }
+  void CardReader::openJobRecoveryFile() { openJobRecoveryFile(false); }
 
-  void CardReader::closeJobRecoveryFile() { jobRecoveryFile.close(); }
+  // The journal stays located; the next save starts a new job header
+  void CardReader::closeJobRecoveryFile() { jobRecoveryHeaderSaved = false; }
 
   bool CardReader::jobRecoverFileExists() {
     const bool exists = jobRecoveryFile.open(&root, job_recovery_file_name, O_READ);
@@ -1001,28 +1165,98 @@ void CardReader::printingHasFinished() {
     return exists;
   }
 
+  /**
+   * Write a journal block: job id, sequence number, data and CRC. The volume
+   * cache is borrowed as the block buffer, and the file is never written
+   * through the cache, so no stale copy of a journal block can be cached.
+   */
+  bool CardReader::writeJobRecoveryBlock(const uint8_t index, const uint32_t sequence, const void * const data, const uint16_t size) {
+    cache_t * const c = volume.cacheClear();
+    if (!c) return false;
+    uint8_t * const buf = c->data;
+    ZERO(c->data);
+    memcpy(buf, &jobRecoveryJob, 4);
+    memcpy(buf + 4, &sequence, 4);
+    memcpy(buf + 8, data, size);
+    uint16_t crc = 0xFFFF;
+    crc16(&crc, buf, 8 + size);
+    memcpy(buf + 8 + size, &crc, 2);
+    return sd2card.writeBlock(jobRecoveryBlock + index, buf);
+  }
+
+  // Read and check a journal block. Data is only copied if not NULL.
+  bool CardReader::readJobRecoveryBlock(const uint8_t index, uint32_t &job, uint32_t &sequence, void * const data, const uint16_t size) {
+    cache_t * const c = volume.cacheClear();
+    if (!c || !sd2card.readBlock(jobRecoveryBlock + index, c->data)) return false;
+    const uint8_t * const buf = c->data;
+    uint16_t crc = 0xFFFF, saved;
+    crc16(&crc, buf, 8 + size);
+    memcpy(&saved, buf + 8 + size, 2);
+    memcpy(&job, buf, 4);
+    if (crc != saved || !job) return false;
+    memcpy(&sequence, buf + 4, 4);
+    if (data) memcpy(data, buf + 8, size);
+    return true;
+  }
+
+  /**
+   * Save the state to the older of the two slots. The first save of a job
+   * also writes the header. Each save is one or two raw block writes. The
+   * whole state is written every time: the card writes whole blocks, so
+   * saving only the changed fields would not save a write.
+   */
   int16_t CardReader::saveJobRecoveryInfo() {
-    jobRecoveryFile.seekSet(0);
-    const int16_t ret = jobRecoveryFile.write(&job_recovery_info, sizeof(job_recovery_info));
-//#ifdef LGT_MAC
-//	if (ret == -1)
-//		LGT_LCD.LGT_Change_Page(ID_DIALOG_NO_FILA);
-//#endif // LGT_MAC
-
-   // #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
-   //  if (ret == -1) SERIAL_PROTOCOLLNPGM("Power-loss file write failed.");
-  //  #endif
-	  if (ret == -1) SERIAL_PROTOCOLLNPGM("Power-loss file write failed.");
-    return ret;
+    bool ok = jobRecoveryBlock;
+    if (ok && !jobRecoveryHeaderSaved && job_recovery_info.valid_head) {
+      if (!++jobRecoveryJob) ++jobRecoveryJob; // non-zero in sequence
+      ok = writeJobRecoveryBlock(0, 0, job_recovery_info.sd_filename, MAXPATHNAMELENGTH);
+      jobRecoveryHeaderSaved = ok;
+    }
+    if (ok) {
+      ++jobRecoverySequence;
+      ok = writeJobRecoveryBlock(1 + (jobRecoverySequence & 1), jobRecoverySequence, &job_recovery_info, JOB_RECOVERY_STATE_SIZE);
+    }
+    if (!ok) {
+      SERIAL_PROTOCOLLNPGM("Power-loss file write failed.");
+      return -1;
+    }
+    return sizeof(job_recovery_info);
   }
 
+  /**
+   * Load the header and the newest state slot, if that slot belongs to
+   * the job in the header. Job ids and sequence numbers continue from
+   * the highest ones found, so stale blocks can never look newer.
+   */
   int16_t CardReader::loadJobRecoveryInfo() {
-    return jobRecoveryFile.read(&job_recovery_info, sizeof(job_recovery_info));
+    if (!jobRecoveryBlock) return -1;
+
+    uint32_t job, sequence, header_job = 0, newest_job = 0;
+    if (readJobRecoveryBlock(0, job, sequence, job_recovery_info.sd_filename, MAXPATHNAMELENGTH))
+      header_job = job;
+    NOLESS(jobRecoveryJob, header_job);
+
+    int8_t newest = 0;
+    for (uint8_t i = 1; i < JOB_RECOVERY_BLOCKS; i++) {
+      if (!readJobRecoveryBlock(i, job, sequence, NULL, JOB_RECOVERY_STATE_SIZE)) continue;
+      NOLESS(jobRecoveryJob, job);
+      if (!newest || sequence > jobRecoverySequence) {
+        newest = i;
+        newest_job = job;
+        jobRecoverySequence = sequence;
+      }
+    }
+
+    if (!newest || newest_job != header_job
+      || !readJobRecoveryBlock(newest, job, sequence, &job_recovery_info, JOB_RECOVERY_STATE_SIZE)
+    ) return -1;
+    return sizeof(job_recovery_info);
   }
 
   void CardReader::removeJobRecoveryFile() {
 	 // MYSERIAL0.println("remove");
     job_recovery_info.valid_head = job_recovery_info.valid_foot = job_recovery_commands_count = 0;
+    jobRecoveryBlock = 0;
     if (jobRecoverFileExists()) {
       closefile();
       removeFile(job_recovery_file_name);
@@ -56,6 +56,7 @@ public:
     #endif
   );
   void getStatus();
+  void reportCacheStats(const bool reset);
   void printingHasFinished();
   void printFilename();
 
@@ -77,6 +78,11 @@ public:
 
   uint16_t get_num_Files();
 
+  #ifdef LGT_MAC
+    uint16_t index_gcode_files(uint16_t * const dir_index, const uint16_t max);
+    void getfilename_at(const uint16_t dir_index);
+  #endif
+
   #if ENABLED(SDCARD_SORT_ALPHA)
     void presort();
     void getfilename_sorted(const uint16_t nr);
@@ -100,8 +106,8 @@ public:
   FORCE_INLINE void pauseSDPrint() { sdprinting = false; }
   FORCE_INLINE bool isFileOpen() { return file.isOpen(); }
   FORCE_INLINE bool eof() { return sdpos >= filesize; }
-  FORCE_INLINE int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  FORCE_INLINE void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  FORCE_INLINE void setIndex(const uint32_t index) { sdpos = index; read_pos = read_len = 0; file.seekSet(index); }
+  int16_t read_line(char * const dst, const uint8_t max, char &term);
   FORCE_INLINE uint32_t getIndex() { return sdpos; }
   FORCE_INLINE uint8_t percentDone() { return (isFileOpen() && filesize) ? sdpos / ((filesize + 99) / 100) : 0; }
   FORCE_INLINE char* getWorkDirName() { workDir.getFilename(filename); return filename; }
@@ -181,6 +187,12 @@ private:
 
   #if ENABLED(POWER_LOSS_RECOVERY)
     SdFile jobRecoveryFile;
+    uint32_t jobRecoveryBlock,        // First block of the journal, 0 if not located
+             jobRecoveryJob,          // Id of the job in the header block
+             jobRecoverySequence;     // Sequence number of the newest state slot
+    bool jobRecoveryHeaderSaved;      // Header written for the job being printed
+    bool writeJobRecoveryBlock(const uint8_t index, const uint32_t sequence, const void * const data, const uint16_t size);
+    bool readJobRecoveryBlock(const uint8_t index, uint32_t &job, uint32_t &sequence, void * const data, const uint16_t size);
   #endif
 
   #define SD_PROCEDURE_DEPTH 1
@@ -190,6 +202,11 @@ private:
   char proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
   uint32_t filesize, sdpos;
 
+  // Buffered reads for read_line(). sdpos is the next byte not yet consumed.
+  uint8_t read_buf[SD_READ_BUFFER_SIZE];
+  uint16_t read_pos, read_len;
+  bool fill_read_buffer();
+
   LsAction lsAction; //stored for recursion.
   uint16_t nrFiles; //counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
   char* diveDirName;
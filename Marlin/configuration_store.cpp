@@ -313,7 +313,7 @@ void MarlinSettings::postprocess() {
     recalc_hangprinter_settings();
   #endif
 
-  #if ENABLED(PIDTEMP)
+  #if ENABLED(PIDTEMP) || ENABLED(PIDTEMPBED)
     thermalManager.updatePID();
   #endif
 
@@ -380,7 +380,8 @@ void MarlinSettings::postprocess() {
 
   const char version[4] = EEPROM_VERSION;
 
-  bool MarlinSettings::eeprom_error, MarlinSettings::validating;
+  bool MarlinSettings::eeprom_error, MarlinSettings::validating,
+       MarlinSettings::comparing, MarlinSettings::eeprom_changed;
 
   void MarlinSettings::write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc) {
     if (eeprom_error) { pos += size; return; }
@@ -390,12 +391,15 @@ void MarlinSettings::postprocess() {
       // EEPROM has only ~100,000 write cycles,
       // so only write bytes that have changed!
       if (v != eeprom_read_byte(p)) {
-        eeprom_write_byte(p, v);
-        if (eeprom_read_byte(p) != v) {
-          SERIAL_ECHO_START();
-          SERIAL_ECHOLNPGM(MSG_ERR_EEPROM_WRITE);
-          eeprom_error = true;
-          return;
+        eeprom_changed = true;
+        if (!comparing) {
+          eeprom_write_byte(p, v);
+          if (eeprom_read_byte(p) != v) {
+            SERIAL_ECHO_START();
+            SERIAL_ECHOLNPGM(MSG_ERR_EEPROM_WRITE);
+            eeprom_error = true;
+            return;
+          }
         }
       }
       crc16(crc, &v, 1);
@@ -427,7 +431,7 @@ void MarlinSettings::postprocess() {
   /**
    * M500 - Store Configuration
    */
-  bool MarlinSettings::save() {
+  bool MarlinSettings::_save() {
     float dummy = 0;
     char ver[4] = "ERR";
 
@@ -437,7 +441,10 @@ void MarlinSettings::postprocess() {
 
     eeprom_error = false;
 
-    EEPROM_WRITE(ver);     // invalidate data first
+    if (comparing)
+      EEPROM_SKIP(ver);    // the stored version is compared at the end
+    else
+      EEPROM_WRITE(ver);   // invalidate data first
     EEPROM_SKIP(working_crc); // Skip the checksum slot
 
     working_crc = 0; // clear before first "real data"
@@ -989,17 +996,31 @@ void MarlinSettings::postprocess() {
 
       EEPROM_WRITE(version);
       EEPROM_WRITE(final_crc);
-      // Report storage size
+      // Report storage size (once, from the pass that ends the save)
       #if ENABLED(EEPROM_CHITCHAT)
-        SERIAL_ECHO_START();
-        SERIAL_ECHOPAIR("Settings Stored (", eeprom_size);
-        SERIAL_ECHOPAIR(" bytes; crc ", (uint32_t)final_crc);
-        SERIAL_ECHOLNPGM(")");
+        if (!comparing || !eeprom_changed) {
+          SERIAL_ECHO_START();
+          SERIAL_ECHOPAIR("Settings Stored (", eeprom_size);
+          SERIAL_ECHOPAIR(" bytes; crc ", (uint32_t)final_crc);
+          SERIAL_ECHOLNPGM(")");
+        }
       #endif
 
       eeprom_error |= size_error(eeprom_size);
     }
 
+    return !eeprom_error;
+  }
+
+  bool MarlinSettings::save() {
+    // Compare everything first, so an M500 that changes
+    // nothing costs no EEPROM writes at all.
+    comparing = true;
+    eeprom_changed = false;
+    bool success = _save();
+    comparing = false;
+    if (success && eeprom_changed) success = _save();
+
     //
     // UBL Mesh
     //
@@ -1008,7 +1029,7 @@ void MarlinSettings::postprocess() {
         store_mesh(ubl.storage_slot);
     #endif
 
-    return !eeprom_error;
+    return success;
   }
 
   /**
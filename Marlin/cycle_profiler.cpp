@@ -0,0 +1,107 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cycle_profiler.h"
+
+#if ENABLED(CYCLE_PROFILER)
+
+#include "Marlin.h"
+
+CycleProfiler profiler;
+
+profile_probe_t CycleProfiler::probes[PROFILE_PROBES];
+volatile uint32_t CycleProfiler::step_timer_base;
+
+static const char probe_name_0[] PROGMEM = "Stepper ISR",
+                  probe_name_1[] PROGMEM = "Temperature ISR",
+                  probe_name_2[] PROGMEM = "Serial RX ISR",
+                  probe_name_3[] PROGMEM = "Serial1 RX ISR",
+                  probe_name_4[] PROGMEM = "manage_heater",
+                  probe_name_5[] PROGMEM = "LGT_Main_Function";
+static const char* const probe_names[PROFILE_PROBES] PROGMEM = {
+  probe_name_0, probe_name_1, probe_name_2, probe_name_3, probe_name_4, probe_name_5
+};
+
+uint32_t CycleProfiler::now() {
+  CRITICAL_SECTION_START;
+  uint32_t base = step_timer_base;
+  hal_timer_t count = HAL_timer_get_count(STEP_TIMER_NUM);
+  // The timer restarted but the Stepper ISR hasn't run yet. Read it again,
+  // as it may have restarted after the first read.
+  if (TEST(TIFR1, OCF1A)) {
+    count = HAL_timer_get_count(STEP_TIMER_NUM);
+    base += uint32_t(HAL_timer_get_compare(STEP_TIMER_NUM)) + 1;
+  }
+  CRITICAL_SECTION_END;
+  return base + count;
+}
+
+/**
+ * Only ever called for a probe by its own ISR or by the main loop, and
+ * the report copies each probe with interrupts off, so no lock is needed.
+ */
+void CycleProfiler::record(const ProfileProbe p, const uint32_t ticks) {
+  profile_probe_t &probe = probes[p];
+  if (!probe.count || ticks < probe.min) probe.min = ticks;
+  NOLESS(probe.max, ticks);
+  probe.total += ticks;
+  if (probe.count < 0xFFFFFFFF) probe.count++;
+
+  uint8_t b = 0;
+  for (uint32_t t = ticks >> 4; t && b < PROFILE_BUCKETS - 1; t >>= 2) b++;
+  if (probe.histogram[b] < 0xFFFF) probe.histogram[b]++;
+}
+
+static void print_us(const char * const label, const float ticks) {
+  serialprintPGM(label);
+  SERIAL_ECHO(ticks * (1.0f / (STEPPER_TIMER_TICKS_PER_US)));
+  SERIAL_ECHOPGM("us");
+}
+
+void CycleProfiler::report(const bool reset) {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPGM("Histogram <8us <32us <128us <512us <2ms <8ms <32ms longer");
+
+  for (uint8_t p = 0; p < PROFILE_PROBES; p++) {
+    CRITICAL_SECTION_START;
+    const profile_probe_t probe = probes[p];
+    if (reset) memset(&probes[p], 0, sizeof(probes[p]));
+    CRITICAL_SECTION_END;
+
+    SERIAL_ECHO_START();
+    serialprintPGM((char*)pgm_read_ptr(&probe_names[p]));
+    SERIAL_ECHOPAIR(" n:", probe.count);
+    if (probe.count) {
+      print_us(PSTR(" min:"), probe.min);
+      print_us(PSTR(" avg:"), float(probe.total) / probe.count);
+      print_us(PSTR(" max:"), probe.max);
+      SERIAL_ECHOPGM(" hist:");
+      for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) {
+        SERIAL_CHAR(' ');
+        SERIAL_ECHO(probe.histogram[b]);
+      }
+    }
+    SERIAL_EOL();
+  }
+}
+
+#endif // CYCLE_PROFILER
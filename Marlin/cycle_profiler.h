@@ -0,0 +1,97 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * cycle_profiler.h - Time ISRs and main loop tasks with the step timer
+ *
+ * Each probe point keeps the count, shortest, longest and mean duration,
+ * and a histogram in powers of 4 from 8us up. Durations are wall time,
+ * so they include any interrupt that ran in the middle.
+ */
+
+#ifndef _CYCLE_PROFILER_H_
+#define _CYCLE_PROFILER_H_
+
+#include "MarlinConfig.h"
+
+#if ENABLED(CYCLE_PROFILER)
+
+enum ProfileProbe : uint8_t {
+  PROFILE_STEPPER_ISR,
+  PROFILE_TEMPERATURE_ISR,
+  PROFILE_SERIAL_RX_ISR,
+  PROFILE_SERIAL1_RX_ISR,
+  PROFILE_MANAGE_HEATER,
+  PROFILE_LGT_MAIN,
+  PROFILE_PROBES
+};
+
+#define PROFILE_BUCKETS 8
+
+typedef struct {
+  uint32_t count,                       // Runs timed
+           min, max;                    // Shortest and longest run, in step timer ticks
+  uint64_t total;                       // Sum of all runs, in step timer ticks
+  uint16_t histogram[PROFILE_BUCKETS];  // Runs <8us, <32us ... <32768us, longer
+} profile_probe_t;
+
+class CycleProfiler {
+  public:
+    static profile_probe_t probes[PROFILE_PROBES];
+    static volatile uint32_t step_timer_base;   // Step timer ticks before the last compare match
+
+    /**
+     * The step timer runs in CTC mode and restarts from 0 at every compare
+     * match, so the Stepper ISR adds each elapsed period to a base before
+     * it programs the next one. Must run first thing in the ISR.
+     */
+    FORCE_INLINE static void step_timer_restarted() {
+      step_timer_base += uint32_t(HAL_timer_get_compare(STEP_TIMER_NUM)) + 1;
+    }
+
+    // Step timer ticks since boot
+    static uint32_t now();
+
+    static void record(const ProfileProbe p, const uint32_t ticks);
+    static void report(const bool reset);
+};
+
+extern CycleProfiler profiler;
+
+// Times the rest of the enclosing scope, including early returns
+class ProfileScope {
+  const ProfileProbe probe;
+  const uint32_t start;
+  public:
+    FORCE_INLINE ProfileScope(const ProfileProbe p) : probe(p), start(CycleProfiler::now()) {}
+    FORCE_INLINE ~ProfileScope() { CycleProfiler::record(probe, CycleProfiler::now() - start); }
+};
+
+#define PROFILE_SCOPE(P) ProfileScope _profile_scope(PROFILE_##P)
+
+#else
+
+#define PROFILE_SCOPE(P) NOOP
+
+#endif // CYCLE_PROFILER
+
+#endif // _CYCLE_PROFILER_H_
@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * eeprom_ring.cpp - Wear-levelled EEPROM storage for frequently saved records
+ */
+
+#include "eeprom_ring.h"
+#include <avr/eeprom.h>
+
+#define SLOT_ADDR(N) (start + (uint16_t)(N) * (size + 1))
+#define SEQ_BYTE(N)  ((uint8_t*)(SLOT_ADDR(N) + size))
+
+/**
+ * The sequence bytes count up around the ring from the oldest slot
+ * to the newest, so the newest slot is the one not followed by its
+ * sequence number plus one.
+ */
+static uint8_t newest_slot(const uint16_t start, const uint8_t slots, const uint8_t size) {
+  uint8_t seq = eeprom_read_byte(SEQ_BYTE(0));
+  for (uint8_t i = 0; i < slots - 1; i++) {
+    const uint8_t next = eeprom_read_byte(SEQ_BYTE(i + 1));
+    if (next != (uint8_t)(seq + 1)) return i;
+    seq = next;
+  }
+  return slots - 1;
+}
+
+void eeprom_ring_read(const uint16_t start, const uint8_t slots, void *data, const uint8_t size) {
+  eeprom_read_block(data, (const void*)SLOT_ADDR(newest_slot(start, slots, size)), size);
+}
+
+void eeprom_ring_write(const uint16_t start, const uint8_t slots, const void *data, const uint8_t size) {
+  const uint8_t n = newest_slot(start, slots, size);
+
+  // Leave the ring alone if the newest record already matches
+  const uint8_t *p = (const uint8_t*)data;
+  uint16_t addr = SLOT_ADDR(n);
+  uint8_t i = 0;
+  while (i < size && eeprom_read_byte((const uint8_t*)addr) == *p) { i++; addr++; p++; }
+  if (i == size) return;
+
+  const uint8_t seq = eeprom_read_byte(SEQ_BYTE(n)) + 1,
+                next = n + 1 < slots ? n + 1 : 0;
+  eeprom_update_block(data, (void*)SLOT_ADDR(next), size);
+  eeprom_update_byte(SEQ_BYTE(next), seq);
+}
+
+void eeprom_ring_format(const uint16_t start, const uint8_t slots, const void *data, const uint8_t size) {
+  for (uint8_t i = 0; i < slots; i++) eeprom_update_byte(SEQ_BYTE(i), i);
+  eeprom_update_block(data, (void*)SLOT_ADDR(slots - 1), size);
+}
@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * eeprom_ring.h - Wear-levelled EEPROM storage for frequently saved records
+ *
+ * A record is kept in a ring of slots, each holding the payload followed by
+ * a sequence byte. Every save that changes the record goes to the slot after
+ * the newest one, so each cell wears at 1/slots the rate of a fixed address.
+ * The sequence byte is written last: a save cut short by a power loss leaves
+ * the previous record as the newest one.
+ */
+
+#ifndef _EEPROM_RING_H_
+#define _EEPROM_RING_H_
+
+#include <stdint.h>
+
+// EEPROM bytes used by a ring of SLOTS records of SIZE bytes
+#define EEPROM_RING_SIZE(SLOTS, SIZE) ((SLOTS) * ((SIZE) + 1))
+
+// Read the newest record
+void eeprom_ring_read(const uint16_t start, const uint8_t slots, void *data, const uint8_t size);
+
+// Save a record into the next slot. Nothing is written if it is unchanged.
+void eeprom_ring_write(const uint16_t start, const uint8_t slots, const void *data, const uint8_t size);
+
+// Set up a new ring (or one with unknown contents) holding the given record
+void eeprom_ring_format(const uint16_t start, const uint8_t slots, const void *data, const uint8_t size);
+
+#endif // _EEPROM_RING_H_
@@ -106,7 +106,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_X_MAX
     #if digitalPinToInterrupt(X_MAX_PIN) != NOT_AN_INTERRUPT // if pin has an external interrupt
       attachInterrupt(digitalPinToInterrupt(X_MAX_PIN), endstop_ISR, CHANGE); // assign it
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(X_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(X_MAX_PIN) != NULL, "X_MAX_PIN is not interrupt-capable"); // if pin has no pin change interrupt - error
       pciSetup(X_MAX_PIN);                                                            // assign it
@@ -116,7 +116,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_X_MIN
     #if digitalPinToInterrupt(X_MIN_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(X_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(X_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(X_MIN_PIN) != NULL, "X_MIN_PIN is not interrupt-capable");
       pciSetup(X_MIN_PIN);
@@ -126,7 +126,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Y_MAX
     #if digitalPinToInterrupt(Y_MAX_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Y_MAX_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Y_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Y_MAX_PIN) != NULL, "Y_MAX_PIN is not interrupt-capable");
       pciSetup(Y_MAX_PIN);
@@ -136,7 +136,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Y_MIN
     #if digitalPinToInterrupt(Y_MIN_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Y_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Y_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Y_MIN_PIN) != NULL, "Y_MIN_PIN is not interrupt-capable");
       pciSetup(Y_MIN_PIN);
@@ -146,7 +146,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Z_MAX
     #if digitalPinToInterrupt(Z_MAX_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Z_MAX_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Z_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Z_MAX_PIN) != NULL, "Z_MAX_PIN is not interrupt-capable");
       pciSetup(Z_MAX_PIN);
@@ -156,7 +156,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Z_MIN
     #if digitalPinToInterrupt(Z_MIN_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Z_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Z_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Z_MIN_PIN) != NULL, "Z_MIN_PIN is not interrupt-capable");
       pciSetup(Z_MIN_PIN);
@@ -166,7 +166,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_X2_MAX
     #if (digitalPinToInterrupt(X2_MAX_PIN) != NOT_AN_INTERRUPT)
       attachInterrupt(digitalPinToInterrupt(X2_MAX_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(X2_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(X2_MAX_PIN) != NULL, "X2_MAX_PIN is not interrupt-capable");
       pciSetup(X2_MAX_PIN);
@@ -176,7 +176,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_X2_MIN
     #if (digitalPinToInterrupt(X2_MIN_PIN) != NOT_AN_INTERRUPT)
       attachInterrupt(digitalPinToInterrupt(X2_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(X2_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(X2_MIN_PIN) != NULL, "X2_MIN_PIN is not interrupt-capable");
       pciSetup(X2_MIN_PIN);
@@ -186,7 +186,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Y2_MAX
     #if (digitalPinToInterrupt(Y2_MAX_PIN) != NOT_AN_INTERRUPT)
       attachInterrupt(digitalPinToInterrupt(Y2_MAX_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Y2_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Y2_MAX_PIN) != NULL, "Y2_MAX_PIN is not interrupt-capable");
       pciSetup(Y2_MAX_PIN);
@@ -196,7 +196,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Y2_MIN
     #if (digitalPinToInterrupt(Y2_MIN_PIN) != NOT_AN_INTERRUPT)
       attachInterrupt(digitalPinToInterrupt(Y2_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Y2_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Y2_MIN_PIN) != NULL, "Y2_MIN_PIN is not interrupt-capable");
       pciSetup(Y2_MIN_PIN);
@@ -206,7 +206,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Z2_MAX
     #if digitalPinToInterrupt(Z2_MAX_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Z2_MAX_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Z2_MAX_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Z2_MAX_PIN) != NULL, "Z2_MAX_PIN is not interrupt-capable");
       pciSetup(Z2_MAX_PIN);
@@ -216,7 +216,7 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Z2_MIN
     #if digitalPinToInterrupt(Z2_MIN_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Z2_MIN_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Z2_MIN_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Z2_MIN_PIN) != NULL, "Z2_MIN_PIN is not interrupt-capable");
       pciSetup(Z2_MIN_PIN);
@@ -226,14 +226,15 @@ void setup_endstop_interrupts( void ) {
   #if HAS_Z_MIN_PROBE_PIN
     #if digitalPinToInterrupt(Z_MIN_PROBE_PIN) != NOT_AN_INTERRUPT
       attachInterrupt(digitalPinToInterrupt(Z_MIN_PROBE_PIN), endstop_ISR, CHANGE);
-    #else
+    #elif ENDSTOP_PIN_HAS_PCINT(Z_MIN_PROBE_PIN)
       // Not all used endstop/probe -pins can raise interrupts. Please deactivate ENDSTOP_INTERRUPTS or change the pin configuration!
       static_assert(digitalPinToPCICR(Z_MIN_PROBE_PIN) != NULL, "Z_MIN_PROBE_PIN is not interrupt-capable");
       pciSetup(Z_MIN_PROBE_PIN);
     #endif
   #endif
 
-  // If we arrive here without raising an assertion, each pin has either an EXT-interrupt or a PCI.
+  // If we arrive here without raising an assertion, each pin has either an EXT-interrupt or a PCI,
+  // or is one of the ENDSTOPS_POLLED pins that Endstops::poll() still reads.
 }
 
 #endif // _ENDSTOP_INTERRUPTS_H_
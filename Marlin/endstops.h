@@ -31,6 +31,52 @@
 
 #define VALIDATE_HOMING_ENDSTOPS
 
+#if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+
+  /**
+   * On the Arduino MEGA an endstop pin with neither an external nor a pin change
+   * interrupt is left to Endstops::poll(), like Z_MIN on the Longer boards.
+   * Elsewhere setup_endstop_interrupts() requires an interrupt on every pin.
+   */
+  #if defined(ARDUINO_AVR_MEGA2560) || defined(ARDUINO_AVR_MEGA)
+    #define ENDSTOP_PIN_HAS_PCINT(P) (WITHIN(P, 10, 15) || WITHIN(P, 50, 53) || WITHIN(P, 62, 69))
+  #else
+    #define ENDSTOP_PIN_HAS_PCINT(P) 1
+  #endif
+  #define ENDSTOP_PIN_IRQ(P) (digitalPinToInterrupt(P) != NOT_AN_INTERRUPT || ENDSTOP_PIN_HAS_PCINT(P))
+  #define _ES_IRQ(S) (HAS_##S && ENDSTOP_PIN_IRQ(S##_PIN))
+  #define _ES_POLLED(S) (HAS_##S && !ENDSTOP_PIN_IRQ(S##_PIN))
+
+  #if _ES_POLLED(X_MIN) || _ES_POLLED(X_MAX) || _ES_POLLED(Y_MIN) || _ES_POLLED(Y_MAX) || _ES_POLLED(Z_MIN) || _ES_POLLED(Z_MAX) \
+   || _ES_POLLED(X2_MIN) || _ES_POLLED(X2_MAX) || _ES_POLLED(Y2_MIN) || _ES_POLLED(Y2_MAX) || _ES_POLLED(Z2_MIN) || _ES_POLLED(Z2_MAX) \
+   || (HAS_Z_MIN_PROBE_PIN && !ENDSTOP_PIN_IRQ(Z_MIN_PROBE_PIN))
+    #define ENDSTOPS_POLLED
+  #endif
+
+  // Homing endstops and probe that stop the axis on the step that triggers them
+  #if DISABLED(X_DUAL_ENDSTOPS) && (X_HOME_DIR < 0 ? _ES_IRQ(X_MIN) : _ES_IRQ(X_MAX))
+    #define X_HOME_IRQ true
+  #else
+    #define X_HOME_IRQ false
+  #endif
+  #if DISABLED(Y_DUAL_ENDSTOPS) && (Y_HOME_DIR < 0 ? _ES_IRQ(Y_MIN) : _ES_IRQ(Y_MAX))
+    #define Y_HOME_IRQ true
+  #else
+    #define Y_HOME_IRQ false
+  #endif
+  #if ENABLED(Z_MIN_PROBE_ENDSTOP) ? (HAS_Z_MIN_PROBE_PIN && ENDSTOP_PIN_IRQ(Z_MIN_PROBE_PIN)) : _ES_IRQ(Z_MIN)
+    #define Z_PROBE_IRQ true
+  #else
+    #define Z_PROBE_IRQ false
+  #endif
+  #if HOMING_Z_WITH_PROBE ? Z_PROBE_IRQ : (DISABLED(Z_DUAL_ENDSTOPS) && (Z_HOME_DIR < 0 ? _ES_IRQ(Z_MIN) : _ES_IRQ(Z_MAX)))
+    #define Z_HOME_IRQ true
+  #else
+    #define Z_HOME_IRQ false
+  #endif
+
+#endif
+
 enum EndstopEnum : char {
   X_MIN,
   Y_MIN,
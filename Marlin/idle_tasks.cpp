@@ -0,0 +1,96 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "idle_tasks.h"
+#include "Marlin.h"
+
+#include <stddef.h>
+
+IdleTasks idle_tasks;
+
+uint16_t IdleTasks::active; // = 0
+
+#if ENABLED(IDLE_TASK_STATS)
+
+  void IdleTasks::record(idle_task_state_t &s, const uint32_t us, const uint16_t budget_us) {
+    uint8_t b = 0;
+    for (uint32_t limit = IDLE_TASK_BUCKET0_US; b < IDLE_TASK_BUCKETS - 1 && us >= limit; limit <<= 1) b++;
+    if (s.runs[b] < 0xFFFF) s.runs[b]++;
+    const uint16_t us16 = us > 0xFFFF ? 0xFFFF : us;
+    NOLESS(s.max_us, us16);
+    if (us16 > budget_us && s.overruns < 0xFFFF) s.overruns++;
+  }
+
+  void IdleTasks::report(const idle_task_t * const table, idle_task_state_t * const state, const uint8_t count, const bool reset) {
+    for (uint8_t t = 0; t < count; t++) {
+      idle_task_state_t &s = state[t];
+      SERIAL_ECHO_START();
+      serialprintPGM(table[t].name);
+      SERIAL_ECHOPAIR(" max:", s.max_us);
+      SERIAL_ECHOPAIR("us over:", s.overruns);
+      SERIAL_ECHOPGM(" hist:");
+      for (uint8_t b = 0; b < IDLE_TASK_BUCKETS; b++) {
+        SERIAL_CHAR(' ');
+        SERIAL_ECHO(s.runs[b]);
+      }
+      SERIAL_EOL();
+      if (reset) {
+        ZERO(s.runs);
+        s.max_us = s.overruns = 0;
+      }
+    }
+  }
+
+#endif
+
+/**
+ * Run every due task of a PROGMEM table, in order.
+ * Time spent in idle() passes nested inside a task counts toward it.
+ */
+void IdleTasks::run(const idle_task_t * const table, idle_task_state_t * const state, const uint8_t count) {
+  for (uint8_t t = 0; t < count; t++) {
+    idle_task_t task;
+    memcpy_P(&task, &table[t], offsetof(idle_task_t, name));
+
+    const uint16_t bit = _BV(t);
+    if (!task.reentrant && TEST(active, t)) continue;
+
+    const millis_t ms = millis();
+    if (task.period_ms) {
+      if (PENDING(ms, state[t].next_run_ms)) continue;
+      state[t].next_run_ms = ms + task.period_ms;
+    }
+
+    #if ENABLED(IDLE_TASK_STATS)
+      const uint32_t start_us = micros();
+    #endif
+
+    const bool nested = TEST(active, t);
+    active |= bit;
+    task.run();
+    if (!nested) active &= ~bit;
+
+    #if ENABLED(IDLE_TASK_STATS)
+      record(state[t], micros() - start_us, task.budget_us);
+    #endif
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * idle_tasks.h - Table-driven scheduler for the work done in idle()
+ */
+
+#ifndef _IDLE_TASKS_H_
+#define _IDLE_TASKS_H_
+
+#include "MarlinConfig.h"
+
+typedef void (*idle_task_fn_t)();
+
+/**
+ * One entry of a PROGMEM task table. A task runs when its period has
+ * elapsed. A task that isn't re-entrant is skipped by idle() passes
+ * nested inside it (e.g., from planner.synchronize() in a handler).
+ */
+typedef struct {
+  idle_task_fn_t run;
+  uint16_t period_ms;   // Minimum time between runs, 0 for every pass
+  uint16_t budget_us;   // Expected worst case, longer runs are overruns
+  bool reentrant;
+  char name[24];        // Only read by the report, so it goes last
+} idle_task_t;
+
+#define IDLE_TASKS_MAX 16 // One bit each in IdleTasks::active
+
+#if ENABLED(IDLE_TASK_STATS)
+  // Runtime histogram buckets: <64us, <128us, ... <4096us, and longer
+  #define IDLE_TASK_BUCKETS 8
+  #define IDLE_TASK_BUCKET0_US 64
+#endif
+
+/**
+ * The RAM state of a task. The owner of the table keeps one per entry,
+ * so the state is sized by the tasks actually built in.
+ */
+typedef struct {
+  millis_t next_run_ms;
+  #if ENABLED(IDLE_TASK_STATS)
+    uint16_t runs[IDLE_TASK_BUCKETS], max_us, overruns;
+  #endif
+} idle_task_state_t;
+
+class IdleTasks {
+  public:
+    static void run(const idle_task_t * const table, idle_task_state_t * const state, const uint8_t count);
+
+    #if ENABLED(IDLE_TASK_STATS)
+      static void report(const idle_task_t * const table, idle_task_state_t * const state, const uint8_t count, const bool reset);
+    #endif
+
+  private:
+    static uint16_t active;   // Bit per task currently on the stack
+
+    #if ENABLED(IDLE_TASK_STATS)
+      static void record(idle_task_state_t &s, const uint32_t us, const uint16_t budget_us);
+    #endif
+};
+
+extern IdleTasks idle_tasks;
+
+#endif // _IDLE_TASKS_H_
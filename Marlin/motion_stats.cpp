@@ -0,0 +1,58 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "motion_stats.h"
+
+#if ENABLED(MOTION_STATS)
+
+#include "Marlin.h"
+
+MotionStats motion_stats;
+
+uint32_t MotionStats::blocks,
+         MotionStats::plan_us;
+uint16_t MotionStats::plan_us_max;
+volatile uint16_t MotionStats::underruns;
+volatile uint32_t MotionStats::step_rate_max;
+volatile bool MotionStats::moving; // = false
+
+void MotionStats::report(const bool reset) {
+  CRITICAL_SECTION_START;
+  const uint16_t u = underruns;
+  const uint32_t r = step_rate_max;
+  if (reset) { underruns = 0; step_rate_max = 0; }
+  CRITICAL_SECTION_END;
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Blocks:", blocks);
+  SERIAL_ECHOPAIR(" plan avg:", blocks ? plan_us / blocks : 0);
+  SERIAL_ECHOPAIR("us max:", plan_us_max);
+  SERIAL_ECHOPAIR("us underruns:", u);
+  SERIAL_ECHOLNPAIR(" max rate:", r);
+
+  if (reset) {
+    blocks = plan_us = 0;
+    plan_us_max = 0;
+  }
+}
+
+#endif // MOTION_STATS
@@ -0,0 +1,62 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * motion_stats.h - Planner and stepper counters for benchmarking motion changes
+ */
+
+#ifndef _MOTION_STATS_H_
+#define _MOTION_STATS_H_
+
+#include "MarlinConfig.h"
+
+class MotionStats {
+  public:
+    static uint32_t blocks,           // Blocks planned
+                    plan_us;          // Total time spent planning them
+    static uint16_t plan_us_max;      // Longest time to plan one block
+    static volatile uint16_t underruns;       // Planner ran dry between moves with commands still queued
+    static volatile uint32_t step_rate_max;   // Fastest step rate the stepper ran
+    static volatile bool moving;              // The command in progress is a move
+
+    // Called for each command. Waits (G4, M109, M400...) drain the planner on purpose.
+    FORCE_INLINE static void command(const char letter, const int codenum) {
+      moving = letter == 'G' && codenum <= 6 && codenum != 4;
+    }
+
+    // Called by the planner for each queued block
+    FORCE_INLINE static void planned(const uint32_t us) {
+      blocks++;
+      plan_us += us;
+      NOLESS(plan_us_max, us > 0xFFFF ? 0xFFFF : uint16_t(us));
+    }
+
+    // Called by the Stepper ISR
+    FORCE_INLINE static void stepping(const uint32_t step_rate) { NOLESS(step_rate_max, step_rate); }
+    FORCE_INLINE static void underrun() { if (moving && underruns < 0xFFFF) underruns++; }
+
+    static void report(const bool reset);
+};
+
+extern MotionStats motion_stats;
+
+#endif // _MOTION_STATS_H_
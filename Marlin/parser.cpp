@@ -43,8 +43,7 @@ bool GCodeParser::volumetric_enabled;
 #endif
 
 char *GCodeParser::command_ptr,
-     *GCodeParser::string_arg,
-     *GCodeParser::value_ptr;
+     *GCodeParser::string_arg;
 char GCodeParser::command_letter;
 int GCodeParser::codenum;
 #if USE_GCODE_SUBCODES
@@ -53,9 +52,12 @@ int GCodeParser::codenum;
 
 #if ENABLED(FASTER_GCODE_PARSER)
   // Optimized Parameters
-  uint32_t GCodeParser::codebits;  // found bits
-  uint8_t GCodeParser::param[26];  // parameter offsets from command_ptr
+  uint32_t GCodeParser::codebits,  // found bits
+           GCodeParser::valbits;   // found bits with a value
+  GCodeParser::param_value_t GCodeParser::param[26];  // decoded parameter values
+  const GCodeParser::param_value_t *GCodeParser::value_ref;
 #else
+  char *GCodeParser::value_ptr;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
@@ -81,8 +83,84 @@ void GCodeParser::reset() {
   #endif
 }
 
+#if ENABLED(FASTER_GCODE_PARSER)
+
+  static const uint32_t param_pow10[] PROGMEM = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+  /**
+   * Decode [-+]?[0-9]*.?[0-9]* as strtod / strtol would read it, but keep
+   * the digits exact so the value can be read as any type without a rescan.
+   * Decimals past 9 digits are dropped and integers saturate at 2^32-1.
+   */
+  void GCodeParser::decode(const char *p, param_value_t &v) {
+    uint8_t point = 0;
+    if (*p == '-') { point = PARAM_NEGATIVE; p++; }
+    else if (*p == '+') p++;
+
+    uint32_t digits = 0;
+    bool frac = false;
+    for (;; p++) {
+      const char c = *p;
+      if (c == '.' && !frac) { frac = true; continue; }
+      if (!NUMERIC(c)) break;
+      if (digits >= 429496729UL || (frac && (point & PARAM_POINT) == 9)) {
+        if (!frac) digits = 0xFFFFFFFFUL;   // No room for another digit
+        continue;
+      }
+      digits = digits * 10 + (c - '0');
+      if (frac) point++;
+    }
+
+    v.digits = digits;
+    v.point = point;
+  }
+
+  /**
+   * Up to 2^24 the digits are an exact float, so one division rounds like
+   * strtod. Longer numbers are split so the integer part stays exact and
+   * only the fraction is rounded before the sum, leaving at most 1 ulp off.
+   */
+  float GCodeParser::value_float() {
+    if (!value_ref) return 0;
+    const uint32_t digits = value_ref->digits;
+    const uint8_t point = value_ref->point & PARAM_POINT;
+    float f;
+    if (!point)
+      f = digits;
+    else {
+      const uint32_t p10 = pgm_read_dword(&param_pow10[point]);
+      if (digits <= 0x1000000UL)
+        f = float(digits) / p10;
+      else {
+        const uint32_t whole = digits / p10;
+        f = float(whole) + float(digits - whole * p10) / p10;
+      }
+    }
+    return (value_ref->point & PARAM_NEGATIVE) ? -f : f;
+  }
+
+  // Fractions truncate toward zero and out-of-range values saturate, like strtol
+  int32_t GCodeParser::value_long() {
+    if (!value_ref) return 0;
+    uint32_t d = value_ref->digits;
+    const uint8_t point = value_ref->point & PARAM_POINT;
+    if (point) d /= pgm_read_dword(&param_pow10[point]);
+    if (value_ref->point & PARAM_NEGATIVE) return d >= 0x80000000UL ? -0x7FFFFFFFL - 1 : -int32_t(d);
+    return d > 0x7FFFFFFFUL ? 0x7FFFFFFFL : int32_t(d);
+  }
+
+  // A minus sign wraps around, like strtoul
+  uint32_t GCodeParser::value_ulong() {
+    if (!value_ref) return 0;
+    uint32_t d = value_ref->digits;
+    const uint8_t point = value_ref->point & PARAM_POINT;
+    if (point) d /= pgm_read_dword(&param_pow10[point]);
+    return (value_ref->point & PARAM_NEGATIVE) ? -d : d;
+  }
+
+#endif // FASTER_GCODE_PARSER
+
 // Populate all fields by parsing a single line of GCode
-// 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
 
   reset(); // No codes to report
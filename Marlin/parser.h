@@ -46,8 +46,8 @@
  *
  *  - Parse a single gcode line for its letter, code, subcode, and parameters
  *  - FASTER_GCODE_PARSER:
- *    - Flags existing params (1 bit each)
- *    - Stores value offsets (1 byte each)
+ *    - Flags existing params and params with a value (1 bit each)
+ *    - Decodes each value once, exactly, as digits and a point position (5 bytes each)
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -55,13 +55,29 @@
  */
 class GCodeParser {
 
+public:
+
+  #if ENABLED(FASTER_GCODE_PARSER)
+    // A decoded parameter value: digits / 10^point, negated with PARAM_NEGATIVE
+    typedef struct {
+      uint32_t digits;              // The digits of the value without the point
+      uint8_t point;                // Digits after the point, plus flags
+    } param_value_t;
+
+    #define PARAM_POINT    0x0F     // Up to 9 decimals are kept
+    #define PARAM_NEGATIVE 0x80
+  #endif
+
 private:
-  static char *value_ptr;           // Set by seen, used to fetch the value
 
   #if ENABLED(FASTER_GCODE_PARSER)
-    static uint32_t codebits;       // Parameters pre-scanned
-    static uint8_t param[26];       // For A-Z, offsets into command args
+    static uint32_t codebits,       // Parameters pre-scanned
+                    valbits;        // Parameters that have a value
+    static param_value_t param[26]; // For A-Z, values decoded by parse()
+    static const param_value_t *value_ref; // Set by seen, used to fetch the value
+    static void decode(const char *p, param_value_t &v);
   #else
+    static char *value_ptr;         // Set by seen, used to fetch the value
     static char *command_args;      // Args start here, for slow scan
   #endif
 
@@ -118,23 +134,28 @@ public:
       return NUMERIC(p[0]) || ((p[0] == '-' || p[0] == '+') && NUMERIC(p[1])); // [-+]?[0-9]
     }
 
-    // Set the flag and pointer for a parameter
-    static void set(const char c, char * const ptr) {
+    // Set the flag and decode the value of a parameter
+    static void set(const char c, const char * const ptr) {
       const uint8_t ind = LETTER_BIT(c);
       if (ind >= COUNT(param)) return;           // Only A-Z
       SBI32(codebits, ind);                      // parameter exists
-      param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
+      if (ptr) {
+        SBI32(valbits, ind);                     // parameter has a value
+        decode(ptr, param[ind]);
+      }
+      else
+        CBI32(valbits, ind);
       #if ENABLED(DEBUG_GCODE_PARSER)
         if (codenum == 800) {
           SERIAL_ECHOPAIR("Set bit ", (int)ind);
           SERIAL_ECHOPAIR(" of codebits (", hex_address((void*)(codebits >> 16)));
           print_hex_word((uint16_t)(codebits & 0xFFFF));
-          SERIAL_ECHOLNPAIR(") | param = ", (int)param[ind]);
+          SERIAL_ECHOLNPAIR(") | digits = ", param[ind].digits);
         }
       #endif
     }
 
-    // Code seen bit was set. If not found, value_ptr is unchanged.
+    // Code seen bit was set. If not found, value_ref is unchanged.
     // This allows "if (seen('A')||seen('B'))" to use the last-found value.
     static bool seen(const char c) {
       const uint8_t ind = LETTER_BIT(c);
@@ -146,8 +167,7 @@ public:
             SERIAL_CHAR('\''); SERIAL_CHAR(c); SERIAL_ECHOLNPGM("' is seen");
           }
         #endif
-        char * const ptr = command_ptr + param[ind];
-        value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
+        value_ref = TEST32(valbits, ind) ? &param[ind] : (param_value_t*)NULL;
       }
       return b;
     }
@@ -179,7 +199,6 @@ public:
   }
 
   // Populate all fields by parsing a single line of GCode
-  // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
@@ -188,34 +207,49 @@ public:
   #endif
 
   // The code value pointer was set
-  FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
+  #if ENABLED(FASTER_GCODE_PARSER)
+    FORCE_INLINE static bool has_value() { return value_ref != NULL; }
+  #else
+    FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
+  #endif
 
   // Seen a parameter with a value
   inline static bool seenval(const char c) { return seen(c) && has_value(); }
 
-  // Float removes 'E' to prevent scientific notation interpretation
-  inline static float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, NULL);
-          *e = c;
-          return ret;
+  #if ENABLED(FASTER_GCODE_PARSER)
+
+    // Values were decoded by parse(), so these are a divide at most
+    static float value_float();
+    static int32_t value_long();
+    static uint32_t value_ulong();
+
+  #else
+
+    // Float removes 'E' to prevent scientific notation interpretation
+    inline static float value_float() {
+      if (value_ptr) {
+        char *e = value_ptr;
+        for (;;) {
+          const char c = *e;
+          if (c == '\0' || c == ' ') break;
+          if (c == 'E' || c == 'e') {
+            *e = '\0';
+            const float ret = strtof(value_ptr, NULL);
+            *e = c;
+            return ret;
+          }
+          ++e;
         }
-        ++e;
+        return strtof(value_ptr, NULL);
       }
-      return strtof(value_ptr, NULL);
+      return 0;
     }
-    return 0;
-  }
 
-  // Code value as a long or ulong
-  inline static int32_t value_long() { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-  inline static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+    // Code value as a long or ulong
+    inline static int32_t value_long() { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
+    inline static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+
+  #endif // !FASTER_GCODE_PARSER
 
   // Code value for use as time
   FORCE_INLINE static millis_t value_millis() { return value_ulong(); }
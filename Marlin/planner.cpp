@@ -81,6 +81,10 @@
   #include "power.h"
 #endif
 
+#if ENABLED(MOTION_STATS)
+  #include "motion_stats.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -137,6 +141,17 @@ float Planner::max_feedrate_mm_s[NUM_AXIS_N], // (mm/s) M203 XYZE - Max speeds
   bool Planner::abort_on_endstop_hit = false;
 #endif
 
+#if ENABLED(POWER_LOSS_RECOVERY)
+  uint32_t Planner::command_sdpos; // = 0
+  float Planner::command_start_z, Planner::command_start_e;
+#endif
+
+#if ENABLED(STEP_ISR_GOVERNOR)
+  uint32_t Planner::governor_rate, // = 0
+           Planner::governed_blocks;
+  uint8_t Planner::governor_load_peak, Planner::governor_window;
+#endif
+
 #if ENABLED(DISTINCT_E_FACTORS)
   uint8_t Planner::last_extruder = 0;     // Respond to extruder change
   #define _EINDEX (E_AXIS + active_extruder)
@@ -690,6 +705,43 @@ void Planner::init() {
 
 #define MINIMAL_STEP_RATE 120
 
+#if ENABLED(STEP_INTERVAL_RAMPS)
+
+  /**
+   * Describe the step intervals from floor_rate up to peak_rate (acceleration)
+   * or from peak_rate down to floor_rate (deceleration) as whole segments of
+   * STEP_RAMP_RATIO. A straight line through a segment overestimates the
+   * intervals by 0.75% on average, so the line is aimed that much lower to
+   * keep the time taken by the ramp.
+   */
+  static void calc_step_ramp(step_ramp_t &ramp, const float &peak_rate, const float &floor_rate, const int32_t accel, const bool decel) {
+    static const float ratio_pow[] = { 1.0f, STEP_RAMP_RATIO, 1.41421356f, 1.68179283f };
+
+    ramp.rate = peak_rate;
+    ramp.segments = 0;
+
+    // Rate ratio = m * 2^(e-1) with 1 <= m < 2. Four segments per power of 2.
+    int e;
+    const float m = 2 * frexp(peak_rate / floor_rate, &e);
+    if (e < 1) return;
+    uint8_t quarters = 0;
+    while (quarters < 3 && ratio_pow[quarters + 1] <= m) quarters++;
+    ramp.segments = ((e - 1) << 2) + quarters;
+    if (!ramp.segments) return;
+
+    // The acceleration ramp starts the whole segments below the peak
+    if (!decel) ramp.rate = ldexp(peak_rate / ratio_pow[quarters], 1 - e);
+
+    const float rate = ramp.rate,
+                interval = (float(STEPPER_TIMER_RATE) * 65536.0f / 1.0075259f) / rate,
+                length = sq(rate) * (decel ? 1.0f - 1.0f / sq(STEP_RAMP_RATIO) : sq(STEP_RAMP_RATIO) - 1.0f) / (2 * accel);
+    ramp.interval = interval;
+    ramp.slope = interval * (decel ? STEP_RAMP_RATIO - 1.0f : 1.0f - 1.0f / STEP_RAMP_RATIO) / length;
+    ramp.length = length * 256;
+  }
+
+#endif // STEP_INTERVAL_RAMPS
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -713,6 +765,10 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     uint32_t cruise_rate = initial_rate;
   #endif
 
+  #if ENABLED(STEP_INTERVAL_RAMPS)
+    float peak_rate = block->nominal_rate;
+  #endif
+
   const int32_t accel = block->acceleration_steps_per_s2;
 
           // Steps required for acceleration, deceleration to/from nominal rate
@@ -734,6 +790,9 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
       // We won't reach the cruising rate. Let's calculate the speed we will reach
       cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
     #endif
+    #if ENABLED(STEP_INTERVAL_RAMPS)
+      peak_rate = MIN(peak_rate, final_speed(initial_rate, accel, accelerate_steps));
+    #endif
   }
   #if ENABLED(S_CURVE_ACCELERATION)
     else // We have some plateau time, so the cruise rate will be the nominal rate
@@ -750,6 +809,13 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     uint32_t deceleration_time_inverse = get_period_inverse(deceleration_time);
   #endif
 
+  #if ENABLED(STEP_INTERVAL_RAMPS)
+    // Ramps only cover the rates where a segment takes STEP_RAMP_MIN_STEPS or more
+    const float ramp_floor = SQRT(accel * (2.0f * (STEP_RAMP_MIN_STEPS) / (sq(STEP_RAMP_RATIO) - 1.0f)));
+    calc_step_ramp(block->accel_ramp, peak_rate, MAX(ramp_floor, float(initial_rate)), accel, false);
+    calc_step_ramp(block->decel_ramp, peak_rate, MAX(ramp_floor, float(final_rate)), accel, true);
+  #endif
+
   // Store new block parameters
   block->accelerate_until = accelerate_steps;
   block->decelerate_after = accelerate_steps + plateau_steps;
@@ -1122,6 +1188,40 @@ void Planner::recalculate_trapezoids() {
   }
 }
 
+#if ENABLED(STEP_ISR_GOVERNOR)
+
+  /**
+   * Once per Stepper ISR load window, adjust the step rate cap for new blocks.
+   * The ISR load grows about in proportion to the step rate, so an overloaded
+   * window scales the fastest rate it ran down to the target load. Under the
+   * low load mark the cap rises by 1/8, and goes once it is twice the rate
+   * the blocks ask for.
+   */
+  void Planner::update_governor() {
+    uint32_t rate;
+    uint8_t window;
+    const uint8_t load = stepper.isr_load(rate, window);
+    if (window == governor_window) return;
+    governor_window = window;
+    NOLESS(governor_load_peak, load);
+
+    if (load > STEP_GOVERNOR_LOAD_HIGH) {
+      if (rate) {
+        uint32_t cap = rate * (STEP_GOVERNOR_LOAD_TARGET) / load;
+        NOLESS(cap, uint32_t(STEP_GOVERNOR_MIN_RATE));
+        if (!governor_rate || cap < governor_rate) governor_rate = cap;
+      }
+    }
+    else if (governor_rate && load < STEP_GOVERNOR_LOAD_LOW) {
+      if (rate < governor_rate >> 1)
+        governor_rate = 0;
+      else
+        governor_rate += governor_rate >> 3;
+    }
+  }
+
+#endif // STEP_ISR_GOVERNOR
+
 void Planner::recalculate() {
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
@@ -1575,6 +1675,10 @@ bool Planner::_buffer_steps(const int32_t (&target)[NUM_AXIS]
   uint8_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
+  #if ENABLED(MOTION_STATS)
+    const uint32_t plan_start_us = micros();
+  #endif
+
   // Fill the block with the specified movement
   if (!_populate_block(block, false, target
     #if HAS_POSITION_FLOAT
@@ -1606,6 +1710,10 @@ bool Planner::_buffer_steps(const int32_t (&target)[NUM_AXIS]
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
+  #if ENABLED(MOTION_STATS)
+    motion_stats.planned(micros() - plan_start_us);
+  #endif
+
   // Movement successfully queued!
   return true;
 }
@@ -1726,6 +1834,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // Clear all flags, including the "busy" bit
   block->flag = 0x00;
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    block->sdpos = command_sdpos;
+    block->start_z = command_start_z;
+    block->start_e = command_start_e;
+  #endif
+
   // Set direction bits
   block->direction_bits = dm;
 
@@ -2081,6 +2195,15 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     if (cs > max_feedrate_mm_s[i]) NOMORE(speed_factor, max_feedrate_mm_s[i] / cs);
   }
 
+  #if ENABLED(STEP_ISR_GOVERNOR)
+    // Hold the block under the step rate the Stepper ISR can keep up with
+    update_governor();
+    if (governor_rate && block->nominal_rate * speed_factor > governor_rate) {
+      speed_factor = float(governor_rate) / block->nominal_rate;
+      governed_blocks++;
+    }
+  #endif
+
   // Max segment time in µs.
   #ifdef XY_FREQUENCY_LIMIT
 
@@ -2494,6 +2617,12 @@ void Planner::buffer_sync_block() {
 
   block->flag = BLOCK_FLAG_SYNC_POSITION;
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    block->sdpos = command_sdpos;
+    block->start_z = command_start_z;
+    block->start_e = command_start_e;
+  #endif
+
   block->position[A_AXIS] = position[A_AXIS];
   block->position[B_AXIS] = position[B_AXIS];
   block->position[C_AXIS] = position[C_AXIS];
@@ -63,6 +63,29 @@ enum BlockFlag : char {
   BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION)
 };
 
+#if ENABLED(STEP_INTERVAL_RAMPS)
+
+  /**
+   * struct step_ramp_t
+   *
+   * The step intervals for the acceleration or deceleration of a block,
+   * as the stepper ISR follows them. Each segment of the ramp changes the
+   * step rate by STEP_RAMP_RATIO with a constant change of the interval
+   * per step. Only the first segment is stored, the following ones scale
+   * from it by constant factors (see Stepper::ramp_next_segment).
+   */
+  #define STEP_RAMP_RATIO 1.18920712f       // 2^(1/4)
+
+  typedef struct {
+    uint32_t rate,                          // Step rate where the acceleration ramp starts / the peak rate
+             interval,                      // Timer ticks per step at the start, Q16
+             slope,                         // Change of the interval per step in the first segment, Q16
+             length;                        // Steps in the first segment, Q8
+    uint8_t segments;                       // Segments in the ramp, 0 for none
+  } step_ramp_t;
+
+#endif
+
 /**
  * struct block_t
  *
@@ -118,6 +141,10 @@ typedef struct {
              deceleration_time_inverse;
   #else
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
+    #if ENABLED(STEP_INTERVAL_RAMPS)
+      step_ramp_t accel_ramp,               // Step intervals for the acceleration and deceleration
+                  decel_ramp;
+    #endif
   #endif
 
   uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
@@ -146,6 +173,11 @@ typedef struct {
 
   uint32_t segment_time_us;
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    uint32_t sdpos;                         // SD offset of the command that queued this block
+    float start_z, start_e;                 // Logical Z and E when that command started
+  #endif
+
 } block_t;
 
 #define HAS_POSITION_FLOAT (ENABLED(LIN_ADVANCE) || HAS_FEEDRATE_SCALING)
@@ -270,6 +302,18 @@ class Planner {
       static bool abort_on_endstop_hit;
     #endif
 
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      static uint32_t command_sdpos;        // Origin of the SD command being processed,
+      static float command_start_z,         // copied into each block it queues
+                   command_start_e;
+    #endif
+
+    #if ENABLED(STEP_ISR_GOVERNOR)
+      static uint32_t governor_rate,        // (steps/s) Cap on the step rate of new blocks, 0 when off
+                      governed_blocks;      // Blocks slowed down by the cap
+      static uint8_t governor_load_peak;    // (%) Highest Stepper ISR load seen
+    #endif
+
   private:
 
     /**
@@ -710,6 +754,18 @@ class Planner {
      */
     FORCE_INLINE static bool has_blocks_queued() { return (block_buffer_head != block_buffer_tail); }
 
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      /**
+       * The block being executed (or about to be). NULL if the buffer is empty.
+       * The ISR may discard it at any time, but its tags stay intact until
+       * the main thread queues a new block.
+       */
+      FORCE_INLINE static const block_t* get_executing_block() {
+        const uint8_t tail = block_buffer_tail;
+        return tail != block_buffer_head ? &block_buffer[tail] : NULL;
+      }
+    #endif
+
     /**
      * The current block. NULL if the buffer is empty.
      * This also marks the block as busy.
@@ -861,7 +917,7 @@ class Planner {
       return target_velocity_sqr - 2 * accel * distance;
     }
 
-    #if ENABLED(S_CURVE_ACCELERATION)
+    #if ENABLED(S_CURVE_ACCELERATION) || ENABLED(STEP_INTERVAL_RAMPS)
       /**
        * Calculate the speed reached given initial speed, acceleration and distance
        */
@@ -882,6 +938,11 @@ class Planner {
 
     static void recalculate();
 
+    #if ENABLED(STEP_ISR_GOVERNOR)
+      static uint8_t governor_window;       // Last Stepper ISR load window the governor acted on
+      static void update_governor();
+    #endif
+
     #if ENABLED(JUNCTION_DEVIATION)
 
       FORCE_INLINE static void normalize_junction_vector(float (&vector)[XYZE]) {
@@ -49,8 +49,8 @@ extern bool check_recovery;
 job_recovery_info_t job_recovery_info;
 JobRecoveryPhase job_recovery_phase = JOB_RECOVERY_IDLE;
 uint8_t job_recovery_commands_count; //=0
-char job_recovery_commands[BUFSIZE + APPEND_CMD_COUNT][MAX_CMD_SIZE];
-extern uint8_t active_extruder, commands_in_queue, cmd_queue_index_r;
+char job_recovery_commands[APPEND_CMD_COUNT][MAX_CMD_SIZE];
+extern uint8_t active_extruder;
 
 #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
   void debug_print_job_recovery(const bool recovery) {
@@ -102,12 +102,8 @@ extern uint8_t active_extruder, commands_in_queue, cmd_queue_index_r;
         //  SERIAL_PROTOCOLPAIR("leveling: ", int(job_recovery_info.leveling));
         //  SERIAL_PROTOCOLLNPAIR(" fade: ", int(job_recovery_info.fade));
         //#endif
-        SERIAL_PROTOCOLLNPAIR("cmd_queue_index_r: ", int(job_recovery_info.cmd_queue_index_r));
-        SERIAL_PROTOCOLLNPAIR("commands_in_queue: ", int(job_recovery_info.commands_in_queue));
         if (recovery)
           for (uint8_t i = 0; i < job_recovery_commands_count; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_commands[i]);
-        else
-          for (uint8_t i = 0; i < job_recovery_info.commands_in_queue; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_info.command_queue[i]);
         SERIAL_PROTOCOLLNPAIR("sd_filename: ", job_recovery_info.sd_filename);
         SERIAL_PROTOCOLLNPAIR("sdpos: ", job_recovery_info.sdpos);
         SERIAL_PROTOCOLLNPAIR("print_job_elapsed: ", job_recovery_info.print_job_elapsed);
@@ -165,12 +161,6 @@ void check_print_job_recovery() {
 		sprintf_P(job_recovery_commands[ind++], PSTR("G92 Z%s E%s"), str_Z, str_E);
 		sprintf_P(job_recovery_commands[ind++], PSTR("G28 R0 X0 Y0"));
 
-        uint8_t r = job_recovery_info.cmd_queue_index_r, c = job_recovery_info.commands_in_queue;
-        while (c--) {
-          strcpy(job_recovery_commands[ind++], job_recovery_info.command_queue[r]);
-          r = (r + 1) % BUFSIZE;
-        }
-
         if (job_recovery_info.sd_filename[0] == '/') job_recovery_info.sd_filename[0] = ' ';
         sprintf_P(job_recovery_commands[ind++], PSTR("M23 %s"), job_recovery_info.sd_filename);
 		sprintf_P(job_recovery_commands[ind++], PSTR("M24 S%ld"), job_recovery_info.sdpos);
@@ -198,9 +188,12 @@ void save_job_recovery_info() {
     static millis_t next_save_ms; // = 0;  // Init on reset
     millis_t ms = millis();
   #endif
-  if ((current_position[2] > 0 &&abs(( current_position[2]+ recovery_z_height) -job_recovery_info.save_current_Z)>=0.1)) 
+  // The saved Z lags the planner, so track the last Z that triggered a save
+  static float last_save_z; // = 0
+  if ((current_position[2] > 0 &&abs(( current_position[2]+ recovery_z_height) -last_save_z)>=0.1)) 
   {
 	  int i = 0;
+	  last_save_z = current_position[2] + recovery_z_height;
     #if SAVE_INFO_INTERVAL_MS > 0
       next_save_ms = ms + SAVE_INFO_INTERVAL_MS;
     #endif
@@ -209,9 +202,20 @@ void save_job_recovery_info() {
     if (!++job_recovery_info.valid_head) ++job_recovery_info.valid_head; // non-zero in sequence
     job_recovery_info.valid_foot = job_recovery_info.valid_head;
 
-    // Machine state
-	job_recovery_info.save_current_Z = current_position[2]+recovery_z_height;
-	job_recovery_info.save_current_E = current_position[3];
+    // Resume from the start of the command that queued the block being
+    // executed. With the planner empty, resume from the next command.
+    const block_t * const block = planner.get_executing_block();
+    if (block) {
+      job_recovery_info.sdpos = block->sdpos;
+      job_recovery_info.save_current_Z = block->start_z + recovery_z_height;
+      job_recovery_info.save_current_E = block->start_e;
+    }
+    else {
+      const uint32_t sdpos = queued_command_sdpos();
+      job_recovery_info.sdpos = sdpos != JOB_RECOVERY_NO_SDPOS ? sdpos : card.getIndex();
+      job_recovery_info.save_current_Z = current_position[2] + recovery_z_height;
+      job_recovery_info.save_current_E = current_position[3];
+    }
 
     job_recovery_info.feedrate = feedrate_mm_s;
 	job_recovery_info.have_percentdone = card.percentDone();
@@ -226,17 +230,11 @@ void save_job_recovery_info() {
       COPY(job_recovery_info.fanSpeeds, fanSpeeds);
     #endif
 
-    // Commands in the queue
-    job_recovery_info.cmd_queue_index_r = cmd_queue_index_r;
-    job_recovery_info.commands_in_queue = commands_in_queue;
-    COPY(job_recovery_info.command_queue, command_queue);
-
     // Elapsed print job time
     job_recovery_info.print_job_elapsed = recovery_time+print_job_timer.duration();
 
-    // SD file position
+    // SD file name
     card.getAbsFilename(job_recovery_info.sd_filename);
-    job_recovery_info.sdpos = card.getIndex();
 
     #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
       SERIAL_PROTOCOLLNPGM("Saving...");
@@ -61,12 +61,8 @@ typedef struct {
   //  float fade;
   //#endif
 
-  // Command queue
-  uint8_t cmd_queue_index_r, commands_in_queue;
-  char command_queue[BUFSIZE][MAX_CMD_SIZE];
-
-  // SD Filename and position
-  char sd_filename[MAXPATHNAMELENGTH];
+  // SD position of the command that queued the block being executed.
+  // Z and E above are where that command started.
   uint32_t sdpos;
 
   // Job elapsed time
@@ -74,8 +70,22 @@ typedef struct {
   //Job percentdone
   uint8_t have_percentdone;
   uint8_t valid_foot;
+
+  // SD Filename. Kept last: it only changes per job, so the journal
+  // stores it in the header block, apart from the state slots.
+  char sd_filename[MAXPATHNAMELENGTH];
 } job_recovery_info_t;
 
+/**
+ * The recovery file is a preallocated contiguous journal written with raw
+ * block writes, so saving never touches the FAT or directory. Block 0 holds
+ * the job header (file name). Blocks 1 and 2 take turns holding the state,
+ * so an interrupted write always leaves the previous state intact. Every
+ * block carries a job id, a sequence number and a CRC.
+ */
+#define JOB_RECOVERY_BLOCKS     3
+#define JOB_RECOVERY_STATE_SIZE offsetof(job_recovery_info_t, sd_filename)
+
 extern job_recovery_info_t job_recovery_info;
 
 enum JobRecoveryPhase : unsigned char {
@@ -92,7 +102,10 @@ extern JobRecoveryPhase job_recovery_phase;
   #define APPEND_CMD_COUNT 7
 #endif
 
-extern char job_recovery_commands[BUFSIZE + APPEND_CMD_COUNT][MAX_CMD_SIZE];
+// Queued commands that did not come from the SD file
+#define JOB_RECOVERY_NO_SDPOS 0xFFFFFFFFUL
+
+extern char job_recovery_commands[APPEND_CMD_COUNT][MAX_CMD_SIZE];
 extern uint8_t job_recovery_commands_count;
 
 void check_print_job_recovery();
@@ -31,6 +31,7 @@ Stopwatch print_job_timer;      // Global Print Job Timer instance
 
 #include "printcounter.h"
 #include "duration_t.h"
+#include "eeprom_ring.h"
 #include "Marlin.h"
 
 PrintCounter print_job_timer;   // Global Print Job Timer instance
@@ -44,6 +45,14 @@ PrintCounter print_job_timer;   // Global Print Job Timer instance
 
 const PrintCounter::promdress PrintCounter::address = STATS_EEPROM_ADDRESS;
 
+// The statistics are kept in a ring of slots after the marker byte,
+// sharing the wear of the periodic saves. It has to end before the
+// settings at EEPROM_OFFSET (100).
+#define STATS_EEPROM_MARKER 0x17    // 0x16 marked a single record
+#define STATS_EEPROM_SLOTS  2
+#define STATS_EEPROM_RING   (STATS_EEPROM_ADDRESS + sizeof(uint8_t))
+static_assert(STATS_EEPROM_RING + EEPROM_RING_SIZE(STATS_EEPROM_SLOTS, sizeof(printStatistics)) <= 100, "The print statistics run into the settings in EEPROM.");
+
 const uint16_t PrintCounter::updateInterval = 10;
 const uint16_t PrintCounter::saveInterval = 3600;
 printStatistics PrintCounter::data;
@@ -79,8 +88,8 @@ void PrintCounter::initStats() {
   loaded = true;
   data = { 0, 0, 0, 0, 0.0 };
 
-  saveStats();
-  eeprom_write_byte((uint8_t*)address, 0x16);
+  eeprom_ring_format(STATS_EEPROM_RING, STATS_EEPROM_SLOTS, &data, sizeof(printStatistics));
+  eeprom_write_byte((uint8_t*)address, STATS_EEPROM_MARKER);
 }
 
 void PrintCounter::loadStats() {
@@ -89,9 +98,18 @@ void PrintCounter::loadStats() {
   #endif
 
   // Checks if the EEPROM block is initialized
-  if (eeprom_read_byte((uint8_t*)address) != 0x16) initStats();
-  else eeprom_read_block(&data,
-    (void*)(address + sizeof(uint8_t)), sizeof(printStatistics));
+  switch (eeprom_read_byte((uint8_t*)address)) {
+    case STATS_EEPROM_MARKER:
+      eeprom_ring_read(STATS_EEPROM_RING, STATS_EEPROM_SLOTS, &data, sizeof(printStatistics));
+      break;
+    case 0x16: // Single record written by older firmware
+      eeprom_read_block(&data, (void*)STATS_EEPROM_RING, sizeof(printStatistics));
+      eeprom_ring_format(STATS_EEPROM_RING, STATS_EEPROM_SLOTS, &data, sizeof(printStatistics));
+      eeprom_write_byte((uint8_t*)address, STATS_EEPROM_MARKER);
+      break;
+    default:
+      initStats();
+  }
 
   loaded = true;
 }
@@ -105,8 +123,7 @@ void PrintCounter::saveStats() {
   if (!isLoaded()) return;
 
   // Saves the struct to EEPROM
-  eeprom_update_block(&data,
-    (void*)(address + sizeof(uint8_t)), sizeof(printStatistics));
+  eeprom_ring_write(STATS_EEPROM_RING, STATS_EEPROM_SLOTS, &data, sizeof(printStatistics));
 }
 
 void PrintCounter::showStats() {
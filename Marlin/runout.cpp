@@ -33,7 +33,9 @@
 FilamentRunoutSensor runout;
 
 bool FilamentRunoutSensor::filament_ran_out; // = false
-uint8_t FilamentRunoutSensor::runout_count; // = 0
+volatile bool FilamentRunoutSensor::out_pending; // = false
+volatile millis_t FilamentRunoutSensor::out_ms;
+volatile int32_t FilamentRunoutSensor::out_e_steps;
 
 void FilamentRunoutSensor::setup() {
 
@@ -56,6 +58,64 @@ void FilamentRunoutSensor::setup() {
       #endif
     #endif
   #endif
+
+  reset();
+
+  #if ENABLED(FIL_RUNOUT_INTERRUPT)
+    attachInterrupt(digitalPinToInterrupt(FIL_RUNOUT_PIN), sense, CHANGE);
+  #endif
+}
+
+void FilamentRunoutSensor::reset() {
+  filament_ran_out = false;
+  CRITICAL_SECTION_START;
+  out_pending = false;
+  sense();
+  CRITICAL_SECTION_END;
+}
+
+/**
+ * Note when the sensor starts reading out, and where the extruder was then.
+ * Any reading of filament present, even a bounce, starts the debounce over.
+ */
+void FilamentRunoutSensor::sense() {
+  if (!is_out())
+    out_pending = false;
+  else if (!out_pending) {
+    out_ms = millis();
+    out_e_steps = stepper.position(E_AXIS);
+    out_pending = true;
+  }
+}
+
+// True once the sensor has read out for FIL_RUNOUT_DEBOUNCE ms straight
+bool FilamentRunoutSensor::debounced() {
+  CRITICAL_SECTION_START;
+  const bool out = out_pending;
+  const millis_t ms = out_ms;
+  CRITICAL_SECTION_END;
+  return out && ELAPSED(millis(), ms + (FIL_RUNOUT_DEBOUNCE));
+}
+
+/**
+ * Hand the runout over to FILAMENT_RUNOUT_SCRIPT without waiting for the
+ * planner to drain, so the main loop keeps running in the meantime.
+ */
+void FilamentRunoutSensor::trigger() {
+  filament_ran_out = true;
+  #ifdef LGT_MAC
+    LGT_LCD.LGT_Change_Page(ID_DIALOG_NO_FILA);
+  #endif
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Filament runout at E", runout_position_e());
+  enqueue_and_echo_commands_P(PSTR(FILAMENT_RUNOUT_SCRIPT));
+}
+
+float FilamentRunoutSensor::runout_position_e() {
+  CRITICAL_SECTION_START;
+  const int32_t steps = out_e_steps;
+  CRITICAL_SECTION_END;
+  return steps * planner.steps_to_mm[E_AXIS];
 }
 
 #endif // FILAMENT_RUNOUT_SENSOR
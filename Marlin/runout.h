@@ -34,7 +34,6 @@
 
 #include "MarlinConfig.h"
 
-#define FIL_RUNOUT_THRESHOLD 20//5
 //extern uint16_t filament_out;
 #if ENABLED(LGT_MAC)
 #include "LGT_SCR.h"
@@ -42,55 +41,66 @@
 	extern bool LGT_is_printing;
 #endif
 
+// A single sensor on a pin with an external interrupt is watched by its ISR, others are polled
+#if NUM_RUNOUT_SENSORS < 2 && digitalPinToInterrupt(FIL_RUNOUT_PIN) != NOT_AN_INTERRUPT
+  #define FIL_RUNOUT_INTERRUPT
+#endif
+
 class FilamentRunoutSensor {
   public:
     FilamentRunoutSensor() {}
 
     static void setup();
 
-    FORCE_INLINE static void reset() { runout_count = 0; filament_ran_out = false; }
+    // Re-arm the sensor, taking the filament as out from now if it still is
+    static void reset();
 
     FORCE_INLINE static void run() {
-		if (
+      #if DISABLED(FIL_RUNOUT_INTERRUPT)
+        sense();
+      #endif
+      if (filament_ran_out || !out_pending) return;
+      if (
 #ifdef LGT_MAC
 	(LGT_is_printing == true)&&
 #endif
-	(IS_SD_PRINTING || print_job_timer.isRunning()) && check() && !filament_ran_out) {
-        filament_ran_out = true;
-#ifdef LGT_MAC
-		//if(LGT_is_printing==true)
-		LGT_LCD.LGT_Change_Page(ID_DIALOG_NO_FILA);
-#endif
-        enqueue_and_echo_commands_P(PSTR(FILAMENT_RUNOUT_SCRIPT));
-        planner.synchronize();
-      }
+	(IS_SD_PRINTING || print_job_timer.isRunning()) && debounced()) trigger();
     }
+
+    // E position, in mm, when the sensor last started reading out
+    static float runout_position_e();
+
   private:
     static bool filament_ran_out;
-    static uint8_t runout_count;
+    static volatile bool out_pending;       // The sensor reads out since out_ms
+    static volatile millis_t out_ms;
+    static volatile int32_t out_e_steps;    // E stepper position at out_ms
+
+    // Called on every change of the sensor pin, and by the polling fallback
+    static void sense();
+    static bool debounced();
+    static void trigger();
 
-    FORCE_INLINE static bool check() {
+    FORCE_INLINE static bool is_out() {
       #if NUM_RUNOUT_SENSORS < 2
         // A single sensor applying to all extruders
-        const bool is_out = READ(FIL_RUNOUT_PIN) == FIL_RUNOUT_INVERTING;
+        return READ(FIL_RUNOUT_PIN) == FIL_RUNOUT_INVERTING;
       #else
         // Read the sensor for the active extruder
-        bool is_out;
         switch (active_extruder) {
-          case 0: is_out = READ(FIL_RUNOUT_PIN) == FIL_RUNOUT_INVERTING; break;
-          case 1: is_out = READ(FIL_RUNOUT2_PIN) == FIL_RUNOUT_INVERTING; break;
+          default: return READ(FIL_RUNOUT_PIN) == FIL_RUNOUT_INVERTING;
+          case 1: return READ(FIL_RUNOUT2_PIN) == FIL_RUNOUT_INVERTING;
           #if NUM_RUNOUT_SENSORS > 2
-            case 2: is_out = READ(FIL_RUNOUT3_PIN) == FIL_RUNOUT_INVERTING; break;
+            case 2: return READ(FIL_RUNOUT3_PIN) == FIL_RUNOUT_INVERTING;
             #if NUM_RUNOUT_SENSORS > 3
-              case 3: is_out = READ(FIL_RUNOUT4_PIN) == FIL_RUNOUT_INVERTING; break;
+              case 3: return READ(FIL_RUNOUT4_PIN) == FIL_RUNOUT_INVERTING;
               #if NUM_RUNOUT_SENSORS > 4
-                case 4: is_out = READ(FIL_RUNOUT5_PIN) == FIL_RUNOUT_INVERTING; break;
+                case 4: return READ(FIL_RUNOUT5_PIN) == FIL_RUNOUT_INVERTING;
               #endif
             #endif
           #endif
         }
       #endif
-      return (is_out ? ++runout_count : (runout_count = 0)) > FIL_RUNOUT_THRESHOLD;
     }
 };
 
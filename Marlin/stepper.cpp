@@ -87,11 +87,16 @@
 #include "cardreader.h"
 #include "speed_lookuptable.h"
 #include "delay.h"
+#include "cycle_profiler.h"
 
 #if HAS_DIGIPOTSS
   #include <SPI.h>
 #endif
 
+#if ENABLED(MOTION_STATS)
+  #include "motion_stats.h"
+#endif
+
 Stepper stepper; // Singleton
 
 // public:
@@ -184,6 +189,25 @@ int32_t Stepper::ticks_nominal = -1;
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
 #endif
 
+#if ENABLED(STEP_INTERVAL_RAMPS)
+  enum StepRampState : char {
+    RAMP_OFF,     // Not on a ramp yet, calc_timer_interval() times the steps
+    RAMP_ACCEL,   // On the acceleration ramp, or holding its end rate
+    RAMP_DECEL,   // On the deceleration ramp
+    RAMP_DONE     // Past the deceleration ramp, calc_timer_interval() takes over again
+  };
+  uint8_t Stepper::ramp_state, Stepper::ramp_segments, Stepper::ramp_shift;
+  uint32_t Stepper::ramp_interval, Stepper::ramp_base, Stepper::ramp_slope, Stepper::ramp_length;
+  int32_t Stepper::ramp_left;
+#endif
+
+#if ENABLED(STEP_ISR_GOVERNOR)
+  volatile uint16_t Stepper::isr_overruns; // = 0
+  uint32_t Stepper::load_busy, Stepper::load_period, Stepper::load_rate;
+  volatile uint32_t Stepper::last_load_busy, Stepper::last_load_period, Stepper::last_load_rate;
+  volatile uint8_t Stepper::load_windows; // = 0
+#endif
+
 volatile int32_t Stepper::endstops_trigsteps[XYZ],
                  Stepper::count_position[NUM_AXIS] = { 0 };
 int8_t Stepper::count_direction[NUM_AXIS] = {
@@ -355,6 +379,19 @@ void Stepper::wake_up() {
   ENABLE_STEPPER_DRIVER_INTERRUPT();
 }
 
+#if ENABLED(STEP_ISR_GOVERNOR)
+
+  uint8_t Stepper::isr_load(uint32_t &rate, uint8_t &window) {
+    CRITICAL_SECTION_START;
+    const uint32_t busy = last_load_busy, period = last_load_period;
+    rate = last_load_rate;
+    window = load_windows;
+    CRITICAL_SECTION_END;
+    return period ? MIN(busy * 100 / period, 100U) : 0;
+  }
+
+#endif
+
 /**
  * Set the stepper direction of each axis
  *
@@ -1149,6 +1186,11 @@ void Stepper::set_directions() {
 HAL_STEP_TIMER_ISR {
   HAL_timer_isr_prologue(STEP_TIMER_NUM);
 
+  #if ENABLED(CYCLE_PROFILER)
+    CycleProfiler::step_timer_restarted();
+  #endif
+  PROFILE_SCOPE(STEPPER_ISR);
+
   Stepper::isr();
 
   HAL_timer_isr_epilogue(STEP_TIMER_NUM);
@@ -1258,7 +1300,12 @@ void Stepper::isr() {
      * loop to 10 iterations. Beyond that, there's no way to ensure correct pulse
      * timing, since the MCU isn't fast enough.
      */
-    if (!--max_loops) next_isr_ticks = min_ticks;
+    if (!--max_loops) {
+      next_isr_ticks = min_ticks;
+      #if ENABLED(STEP_ISR_GOVERNOR)
+        if (isr_overruns < 0xFFFF) isr_overruns++;
+      #endif
+    }
 
     // Advance pulses if not enough time to wait for the next ISR
   } while (next_isr_ticks < min_ticks);
@@ -1266,6 +1313,21 @@ void Stepper::isr() {
   // Now 'next_isr_ticks' contains the period to the next Stepper ISR - And we are
   // sure that the time has not arrived yet - Warrantied by the scheduler
 
+  #if ENABLED(STEP_ISR_GOVERNOR)
+    // The timer restarted from 0 when this ISR was triggered, so its count
+    // is the time spent in here, and 'next_isr_ticks' the whole period.
+    load_busy += HAL_timer_get_count(STEP_TIMER_NUM);
+    load_period += next_isr_ticks;
+    if (load_period >= STEP_ISR_LOAD_WINDOW) {
+      last_load_busy = load_busy;
+      last_load_period = load_period;
+      last_load_rate = load_rate;
+      load_windows++;
+      load_busy = load_period = 0;
+      load_rate = current_block ? current_block->nominal_rate : 0;
+    }
+  #endif
+
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(STEP_TIMER_NUM, hal_timer_t(next_isr_ticks));
 
@@ -1458,6 +1520,90 @@ void Stepper::stepper_pulse_phase_isr() {
   } while (events_to_do);
 }
 
+#if ENABLED(STEP_INTERVAL_RAMPS)
+
+  // Timer ticks per step (Q16) under which calc_timer_interval() doubles the steps per ISR
+  #define RAMP_MULTISTEP(N) uint32_t((uint64_t(STEPPER_TIMER_RATE) << 16) / (MAX_STEP_ISR_FREQUENCY_##N##X))
+
+  #if DISABLED(DISABLE_MULTI_STEPPING)
+    static const uint32_t ramp_multistep[] PROGMEM = {
+      RAMP_MULTISTEP(1), RAMP_MULTISTEP(2), RAMP_MULTISTEP(4), RAMP_MULTISTEP(8),
+      RAMP_MULTISTEP(16), RAMP_MULTISTEP(32), RAMP_MULTISTEP(64), RAMP_MULTISTEP(128)
+    };
+  #endif
+
+  // v * q16 / 65536 without a 64-bit multiply
+  static FORCE_INLINE uint32_t ramp_scale(const uint32_t v, const uint16_t q16) {
+    return (v >> 16) * q16 + (((v & 0xFFFF) * q16) >> 16);
+  }
+
+  void Stepper::ramp_start(const step_ramp_t &ramp, const uint8_t state) {
+    ramp_state = state;
+    ramp_segments = ramp.segments;
+    ramp_interval = ramp_base = ramp.interval;
+    ramp_slope = ramp.slope;
+    ramp_left = ramp_length = ramp.length;
+
+    // Carry on with the steps per ISR calc_timer_interval() last chose
+    ramp_shift = 0;
+    while (_BV(ramp_shift) < steps_per_isr) ramp_shift++;
+  }
+
+  /**
+   * Give the interval to the next ISR and move along the ramp by the steps
+   * of this one. Only additions and shifts, except at the end of a segment.
+   */
+  FORCE_INLINE uint32_t Stepper::ramp_next_interval() {
+    #if DISABLED(DISABLE_MULTI_STEPPING)
+      // Step as many times per ISR as calc_timer_interval() would at this rate
+      if (ramp_shift < 7 && ramp_interval < pgm_read_dword(&ramp_multistep[ramp_shift])) ramp_shift++;
+      else if (ramp_shift && ramp_interval >= pgm_read_dword(&ramp_multistep[ramp_shift - 1])) ramp_shift--;
+      steps_per_isr = _BV(ramp_shift);
+      const uint32_t interval = ramp_interval >> (16 - ramp_shift);
+    #else
+      const uint32_t interval = MAX(ramp_interval, RAMP_MULTISTEP(1)) >> 16;
+    #endif
+
+    const uint32_t change = ramp_slope << ramp_shift;
+    if (ramp_state == RAMP_DECEL) ramp_interval += change; else ramp_interval -= change;
+    ramp_left -= int32_t(steps_per_isr) << 8;
+    if (ramp_left <= 0) ramp_next_segment();
+
+    return interval;
+  }
+
+  /**
+   * Each segment spans a STEP_RAMP_RATIO (q) change of the step rate, so it
+   * starts at q^-1 times the interval of the one before, takes q^2 times the
+   * steps and has q^-3 times the slope when accelerating. Decelerating, the
+   * other way around. Starting each segment from the exact interval keeps
+   * the rounding of the steps in a segment from adding up along the ramp.
+   */
+  void Stepper::ramp_next_segment() {
+    if (--ramp_segments) {
+      if (ramp_state == RAMP_DECEL) {
+        ramp_base += ramp_scale(ramp_base, 12400);    // * q
+        ramp_length = ramp_scale(ramp_length, 46341); // * q^-2
+        ramp_slope += ramp_scale(ramp_slope, 44682);  // * q^3
+      }
+      else {
+        ramp_base = ramp_scale(ramp_base, 55109);      // * q^-1
+        ramp_length += ramp_scale(ramp_length, 27146); // * q^2
+        ramp_slope = ramp_scale(ramp_slope, 38968);    // * q^-3
+      }
+      ramp_interval = ramp_base;
+      ramp_left += ramp_length;
+    }
+    else if (ramp_state == RAMP_DECEL)
+      ramp_state = RAMP_DONE;   // calc_timer_interval() takes it down to the final rate
+    else {
+      ramp_slope = 0;           // Hold the peak rate up to the cruise or deceleration
+      ramp_left = 0x7FFFFFFF;
+    }
+  }
+
+#endif // STEP_INTERVAL_RAMPS
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
@@ -1475,6 +1621,10 @@ uint32_t Stepper::stepper_block_phase_isr() {
       axis_did_move = 0;
       current_block = NULL;
       planner.discard_current_block();
+      #if ENABLED(MOTION_STATS)
+        // Nothing ready behind it while a move is still being planned or queued
+        if (!planner.has_blocks_queued() && commands_in_queue) motion_stats.underrun();
+      #endif
     }
     else {
       // Step events not completed yet...
@@ -1482,21 +1632,36 @@ uint32_t Stepper::stepper_block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate =
-            acceleration_time < current_block->acceleration_time
-              ? _eval_bezier_curve(acceleration_time)
-              : current_block->cruise_rate;
-        #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+        #if ENABLED(STEP_INTERVAL_RAMPS)
+          // Follow the ramp once the rate gets to its start
+          if (ramp_state == RAMP_OFF && current_block->accel_ramp.segments && acc_step_rate >= current_block->accel_ramp.rate)
+            ramp_start(current_block->accel_ramp, RAMP_ACCEL);
+
+          if (ramp_state == RAMP_ACCEL)
+            interval = ramp_next_interval();
+          else
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate =
+              acceleration_time < current_block->acceleration_time
+                ? _eval_bezier_curve(acceleration_time)
+                : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
+
+          // acc_step_rate is in steps/second
 
-        // acc_step_rate is in steps/second
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
+          #if ENABLED(MOTION_STATS)
+            motion_stats.stepping(acc_step_rate);
+          #endif
+        }
         acceleration_time += interval;
 
         #if ENABLED(LIN_ADVANCE)
@@ -1509,39 +1674,68 @@ uint32_t Stepper::stepper_block_phase_isr() {
       }
       // Are we in Deceleration phase ?
       else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
-
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
 
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
+        #if ENABLED(STEP_INTERVAL_RAMPS)
+          /**
+           * The deceleration ramp starts from the peak rate the planner worked out.
+           * Follow it only if the steps got there, by the end of the acceleration
+           * ramp or by calc_timer_interval(). Otherwise decelerate with
+           * calc_timer_interval() from the rate the steps really reached.
+           */
+          if (ramp_state < RAMP_DECEL) {
+            const bool at_peak = ramp_state == RAMP_ACCEL ? !ramp_segments : acc_step_rate >= current_block->decel_ramp.rate;
+            if (at_peak)
+              acc_step_rate = current_block->decel_ramp.rate;
+            else if (ramp_state == RAMP_ACCEL)
+              acc_step_rate = uint32_t(STEPPER_TIMER_RATE) * 256 / (ramp_interval >> 8);
+            if (at_peak && current_block->decel_ramp.segments)
+              ramp_start(current_block->decel_ramp, RAMP_DECEL);
+            else
+              ramp_state = RAMP_DONE;
+            #if ENABLED(MOTION_STATS)
+              motion_stats.stepping(acc_step_rate);
+            #endif
           }
+
+          if (ramp_state == RAMP_DECEL)
+            interval = ramp_next_interval();
           else
-            step_rate = current_block->final_rate;
         #endif
+        {
+          uint32_t step_rate;
+
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
+          #else
 
-        // step_rate is in steps/second
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+          #endif
+
+          // step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
+        }
         deceleration_time += interval;
 
         #if ENABLED(LIN_ADVANCE)
@@ -1567,6 +1761,9 @@ uint32_t Stepper::stepper_block_phase_isr() {
         if (ticks_nominal < 0) {
           // step_rate to timer interval and loops for the nominal speed
           ticks_nominal = calc_timer_interval(current_block->nominal_rate, oversampling_factor, &steps_per_isr);
+          #if ENABLED(MOTION_STATS)
+            motion_stats.stepping(current_block->nominal_rate);
+          #endif
         }
 
         // The timer interval is just the nominal value for the nominal speed
@@ -1673,6 +1870,10 @@ uint32_t Stepper::stepper_block_phase_isr() {
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
 
+      #if ENABLED(STEP_ISR_GOVERNOR)
+        NOLESS(load_rate, current_block->nominal_rate);
+      #endif
+
       uint8_t oversampling = 0;                         // Assume we won't use it
 
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
@@ -1778,6 +1979,11 @@ uint32_t Stepper::stepper_block_phase_isr() {
         acc_step_rate = current_block->initial_rate;
       #endif
 
+      #if ENABLED(STEP_INTERVAL_RAMPS)
+        // Start timing the steps with calc_timer_interval()
+        ramp_state = RAMP_OFF;
+      #endif
+
       #if ENABLED(S_CURVE_ACCELERATION)
         // Initialize the Bézier speed curve
         _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
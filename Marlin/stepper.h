@@ -185,6 +185,9 @@
 // The minimum allowable frequency for step smoothing will be 1/10 of the maximum nominal frequency (in Hz)
 #define MIN_STEP_ISR_FREQUENCY MAX_STEP_ISR_FREQUENCY_1X
 
+// Timer ticks over which the Stepper ISR measures its load (16ms)
+#define STEP_ISR_LOAD_WINDOW ((STEPPER_TIMER_RATE) / 64)
+
 //
 // Stepper class definition
 //
@@ -226,6 +229,10 @@ class Stepper {
 
   public:
 
+    #if ENABLED(STEP_ISR_GOVERNOR)
+      static volatile uint16_t isr_overruns;    // Times the ISR gave up catching up after max_loops
+    #endif
+
     #if ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
       static bool homing_dual_axis;
     #endif
@@ -312,6 +319,25 @@ class Stepper {
       static uint32_t acc_step_rate; // needed for deceleration start point
     #endif
 
+    #if ENABLED(STEP_INTERVAL_RAMPS)
+      static uint8_t ramp_state,      // Which ramp of the block is being followed, if any
+                     ramp_segments,   // Segments left in the ramp
+                     ramp_shift;      // log2 of the steps per ISR on the ramp
+      static uint32_t ramp_interval,  // Timer ticks per step, Q16
+                      ramp_base,      // ramp_interval at the start of the segment
+                      ramp_slope,     // Change of ramp_interval per step, Q16
+                      ramp_length;    // Steps in the current segment, Q8
+      static int32_t ramp_left;       // Steps left in the current segment, Q8
+    #endif
+
+    #if ENABLED(STEP_ISR_GOVERNOR)
+      static uint32_t load_busy,      // Ticks spent in the ISR in the current window
+                      load_period,    // Ticks elapsed in the current window
+                      load_rate;      // Fastest nominal rate of the blocks run in the current window
+      static volatile uint32_t last_load_busy, last_load_period, last_load_rate; // The last complete window
+      static volatile uint8_t load_windows;   // Count of complete windows
+    #endif
+
     static volatile int32_t endstops_trigsteps[XYZ];
 
     //
@@ -363,6 +389,11 @@ class Stepper {
     // to notify the subsystem that it is time to go to work.
     static void wake_up();
 
+    #if ENABLED(STEP_ISR_GOVERNOR)
+      // Load of the ISR over the last window, in percent, with the fastest block rate and window count
+      static uint8_t isr_load(uint32_t &rate, uint8_t &window);
+    #endif
+
     // Quickly stop all steppers
     FORCE_INLINE static void quick_stop() { abort_current_block = true; }
 
@@ -470,6 +501,12 @@ class Stepper {
     // Allow reset_stepper_drivers to access private set_directions
     friend void reset_stepper_drivers();
 
+    #if ENABLED(STEP_INTERVAL_RAMPS)
+      static void ramp_start(const step_ramp_t &ramp, const uint8_t state);
+      FORCE_INLINE static uint32_t ramp_next_interval();
+      static void ramp_next_segment();
+    #endif
+
     FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t scale, uint8_t* loops) {
       uint32_t timer;
 
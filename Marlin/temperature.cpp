@@ -33,6 +33,7 @@
 #include "printcounter.h"
 #include "delay.h"
 #include "endstops.h"
+#include "cycle_profiler.h"
 
 #if ENABLED(LGT_MAC)
 #include "LGT_SCR.h"
@@ -119,13 +120,17 @@ int16_t Temperature::current_temperature_raw[HOTENDS] = { 0 },
     millis_t Temperature::watch_bed_next_ms = 0;
   #endif
   #if ENABLED(PIDTEMPBED)
-    float Temperature::bedKp, Temperature::bedKi, Temperature::bedKd, // Initialized by settings.load()
-          Temperature::temp_iState_bed = { 0 },
-          Temperature::temp_dState_bed = { 0 },
-          Temperature::pTerm_bed,
-          Temperature::iTerm_bed,
-          Temperature::dTerm_bed,
-          Temperature::pid_error_bed;
+    float Temperature::bedKp, Temperature::bedKi, Temperature::bedKd; // Initialized by settings.load()
+    #if ENABLED(PID_FIXED_POINT)
+      pid_fixed_t Temperature::pid_fixed_bed;
+    #else
+      float Temperature::temp_iState_bed = { 0 },
+            Temperature::temp_dState_bed = { 0 },
+            Temperature::pTerm_bed,
+            Temperature::iTerm_bed,
+            Temperature::dTerm_bed,
+            Temperature::pid_error_bed;
+    #endif
   #else
     millis_t Temperature::next_bed_check_ms;
   #endif
@@ -179,11 +184,16 @@ int16_t Temperature::current_temperature_raw[HOTENDS] = { 0 },
 volatile bool Temperature::temp_meas_ready = false;
 
 #if ENABLED(PIDTEMP)
-  float Temperature::temp_iState[HOTENDS] = { 0 },
-        Temperature::temp_dState[HOTENDS] = { 0 },
-        Temperature::pTerm[HOTENDS],
-        Temperature::iTerm[HOTENDS],
-        Temperature::dTerm[HOTENDS];
+  #if ENABLED(PID_FIXED_POINT)
+    pid_fixed_t Temperature::pid_fixed[HOTENDS];
+  #else
+    float Temperature::temp_iState[HOTENDS] = { 0 },
+          Temperature::temp_dState[HOTENDS] = { 0 },
+          Temperature::pTerm[HOTENDS],
+          Temperature::iTerm[HOTENDS],
+          Temperature::dTerm[HOTENDS],
+          Temperature::pid_error[HOTENDS];
+  #endif
 
   #if ENABLED(PID_EXTRUSION_SCALING)
     float Temperature::cTerm[HOTENDS];
@@ -192,7 +202,6 @@ volatile bool Temperature::temp_meas_ready = false;
     int Temperature::lpq_ptr = 0;
   #endif
 
-  float Temperature::pid_error[HOTENDS];
   bool Temperature::pid_reset[HOTENDS];
 #endif
 
@@ -492,7 +501,7 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
           bedKp = workKp; \
           bedKi = scalePID_i(workKi); \
           bedKd = scalePID_d(workKd); \
-        }while(0)
+          updatePID(); }while(0)
 
         #define _SET_EXTRUDER_PID() do { \
           PID_PARAM(Kp, hotend) = workKp; \
@@ -531,6 +540,92 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
 
 Temperature::Temperature() { }
 
+#if ENABLED(PID_FIXED_POINT)
+
+  #define PID_FIXED_LIMIT 10000 // Largest magnitude of a term, so P + I - D stays inside Q16.16
+
+  /**
+   * Q16.16 product from 16-bit halves, so AVR never needs a 64-bit multiply.
+   * The caller keeps the result under PID_FIXED_LIMIT.
+   */
+  static fixed_t fixmul(const fixed_t a, const fixed_t b) {
+    const uint32_t ua = a < 0 ? -uint32_t(a) : uint32_t(a),
+                   ub = b < 0 ? -uint32_t(b) : uint32_t(b);
+    const uint16_t ah = ua >> 16, al = ua, bh = ub >> 16, bl = ub;
+    const uint32_t r = ((uint32_t(ah) * bh) << 16)
+                     + uint32_t(ah) * bl + uint32_t(al) * bh
+                     + ((uint32_t(al) * bl) >> 16);
+    return (a < 0) != (b < 0) ? -fixed_t(r) : fixed_t(r);
+  }
+
+  // The largest input that keeps K * input within PID_FIXED_LIMIT
+  static fixed_t pid_fixed_range(const fixed_t K) {
+    const float k = FIXED_TO_FLOAT(K);
+    return FIXED(k > 1 ? PID_FIXED_LIMIT / k : PID_FIXED_LIMIT);
+  }
+
+  /**
+   * Load the scaled float gains and derive the limits that keep every
+   * product in range. Each term only reaches a limit at PID_FIXED_LIMIT,
+   * far past the point where the output saturates.
+   */
+  static void set_pid_fixed(pid_fixed_t &pid, const float Kp, const float Ki, const float Kd) {
+    pid.Kp = FIXED(constrain(Kp, 0, PID_FIXED_LIMIT));
+    pid.Ki = FIXED(constrain(Ki, 0, PID_FIXED_LIMIT));
+    pid.Kd = FIXED(constrain(float(PID_K2) * Kd, 0, PID_FIXED_LIMIT)); // The D smoothing factor is folded in
+    pid.error_max = pid_fixed_range(pid.Kp);
+    pid.iState_max = pid_fixed_range(pid.Ki);
+    pid.delta_max = pid_fixed_range(pid.Kd);
+    pid.pTerm = pid.dTerm = 0;
+  }
+
+  /**
+   * Smoothed D term, as in the float loop. It is only held to
+   * PID_FIXED_LIMIT, where the output has long been saturated.
+   */
+  static void pid_fixed_dterm(pid_fixed_t &pid, const fixed_t input) {
+    const fixed_t delta = constrain(input - pid.dState, -pid.delta_max, pid.delta_max);
+    pid.dTerm = constrain(fixmul(pid.Kd, delta) + fixmul(FIXED(PID_K1), pid.dTerm), -FIXED_INT(PID_FIXED_LIMIT), FIXED_INT(PID_FIXED_LIMIT));
+    pid.dState = input;
+  }
+
+  // P + I - D with conditional un-integration, like the float loop. Returns whole PWM counts.
+  static int16_t pid_fixed_output(pid_fixed_t &pid, const fixed_t error, const int16_t max_out) {
+    const fixed_t e = constrain(error, -pid.error_max, pid.error_max);
+    pid.iState = constrain(pid.iState + e, -pid.iState_max, pid.iState_max);
+    pid.pTerm = fixmul(pid.Kp, e);
+    const fixed_t out = pid.pTerm + fixmul(pid.Ki, pid.iState) - pid.dTerm;
+    if (out > FIXED_INT(max_out)) {
+      if (e > 0) pid.iState -= e; // conditional un-integration
+      return max_out;
+    }
+    if (out < 0) {
+      if (e < 0) pid.iState -= e; // conditional un-integration
+      return 0;
+    }
+    return out >> 16;
+  }
+
+#endif // PID_FIXED_POINT
+
+#if ENABLED(PIDTEMP) || ENABLED(PIDTEMPBED)
+
+  void Temperature::updatePID() {
+    #if ENABLED(PIDTEMP)
+      #if ENABLED(PID_EXTRUSION_SCALING)
+        last_e_position = 0;
+      #endif
+      #if ENABLED(PID_FIXED_POINT)
+        HOTEND_LOOP() set_pid_fixed(pid_fixed[e], PID_PARAM(Kp, e), PID_PARAM(Ki, e), PID_PARAM(Kd, e));
+      #endif
+    #endif
+    #if ENABLED(PIDTEMPBED) && ENABLED(PID_FIXED_POINT)
+      set_pid_fixed(pid_fixed_bed, bedKp, bedKi, bedKd);
+    #endif
+  }
+
+#endif
+
 int Temperature::getHeaterPower(const int heater) {
   return (
     #if HAS_HEATED_BED
@@ -639,7 +734,34 @@ float Temperature::get_pid_output(const int8_t e) {
   #endif
   float pid_output;
   #if ENABLED(PIDTEMP)
-    #if DISABLED(PID_OPENLOOP)
+    #if ENABLED(PID_FIXED_POINT) && DISABLED(PID_OPENLOOP)
+      pid_fixed_t &pid = pid_fixed[HOTEND_INDEX];
+      const fixed_t input = FIXED(current_temperature[HOTEND_INDEX]),
+                    pid_error = FIXED_INT(target_temperature[HOTEND_INDEX]) - input;
+      pid_fixed_dterm(pid, input);
+      #if HEATER_IDLE_HANDLER
+        if (heater_idle_timeout_exceeded[HOTEND_INDEX]) {
+          pid_output = 0;
+          pid_reset[HOTEND_INDEX] = true;
+        }
+        else
+      #endif
+      if (pid_error > FIXED_INT(PID_FUNCTIONAL_RANGE)) {
+        pid_output = BANG_MAX;
+        pid_reset[HOTEND_INDEX] = true;
+      }
+      else if (pid_error < -FIXED_INT(PID_FUNCTIONAL_RANGE) || target_temperature[HOTEND_INDEX] == 0) {
+        pid_output = 0;
+        pid_reset[HOTEND_INDEX] = true;
+      }
+      else {
+        if (pid_reset[HOTEND_INDEX]) {
+          pid.iState = 0;
+          pid_reset[HOTEND_INDEX] = false;
+        }
+        pid_output = pid_fixed_output(pid, pid_error, PID_MAX);
+      }
+    #elif DISABLED(PID_OPENLOOP)
       pid_error[HOTEND_INDEX] = target_temperature[HOTEND_INDEX] - current_temperature[HOTEND_INDEX];
       dTerm[HOTEND_INDEX] = PID_K2 * PID_PARAM(Kd, HOTEND_INDEX) * (current_temperature[HOTEND_INDEX] - temp_dState[HOTEND_INDEX]) + float(PID_K1) * dTerm[HOTEND_INDEX];
       temp_dState[HOTEND_INDEX] = current_temperature[HOTEND_INDEX];
@@ -708,9 +830,15 @@ float Temperature::get_pid_output(const int8_t e) {
       SERIAL_ECHOPAIR(MSG_PID_DEBUG, HOTEND_INDEX);
       SERIAL_ECHOPAIR(MSG_PID_DEBUG_INPUT, current_temperature[HOTEND_INDEX]);
       SERIAL_ECHOPAIR(MSG_PID_DEBUG_OUTPUT, pid_output);
-      SERIAL_ECHOPAIR(MSG_PID_DEBUG_PTERM, pTerm[HOTEND_INDEX]);
-      SERIAL_ECHOPAIR(MSG_PID_DEBUG_ITERM, iTerm[HOTEND_INDEX]);
-      SERIAL_ECHOPAIR(MSG_PID_DEBUG_DTERM, dTerm[HOTEND_INDEX]);
+      #if ENABLED(PID_FIXED_POINT)
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_PTERM, FIXED_TO_FLOAT(pid_fixed[HOTEND_INDEX].pTerm));
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_ITERM, FIXED_TO_FLOAT(fixmul(pid_fixed[HOTEND_INDEX].Ki, pid_fixed[HOTEND_INDEX].iState)));
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_DTERM, FIXED_TO_FLOAT(pid_fixed[HOTEND_INDEX].dTerm));
+      #else
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_PTERM, pTerm[HOTEND_INDEX]);
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_ITERM, iTerm[HOTEND_INDEX]);
+        SERIAL_ECHOPAIR(MSG_PID_DEBUG_DTERM, dTerm[HOTEND_INDEX]);
+      #endif
       #if ENABLED(PID_EXTRUSION_SCALING)
         SERIAL_ECHOPAIR(MSG_PID_DEBUG_CTERM, cTerm[HOTEND_INDEX]);
       #endif
@@ -732,7 +860,11 @@ float Temperature::get_pid_output(const int8_t e) {
 #if ENABLED(PIDTEMPBED)
   float Temperature::get_pid_output_bed() {
     float pid_output;
-    #if DISABLED(PID_OPENLOOP)
+    #if ENABLED(PID_FIXED_POINT) && DISABLED(PID_OPENLOOP)
+      const fixed_t input = FIXED(current_temperature_bed);
+      pid_fixed_dterm(pid_fixed_bed, input);
+      pid_output = pid_fixed_output(pid_fixed_bed, FIXED_INT(target_temperature_bed) - input, MAX_BED_POWER);
+    #elif DISABLED(PID_OPENLOOP)
       pid_error_bed = target_temperature_bed - current_temperature_bed;
       pTerm_bed = bedKp * pid_error_bed;
       temp_iState_bed += pid_error_bed;
@@ -761,12 +893,21 @@ float Temperature::get_pid_output(const int8_t e) {
       SERIAL_ECHO(current_temperature_bed);
       SERIAL_ECHOPGM(" Output ");
       SERIAL_ECHO(pid_output);
-      SERIAL_ECHOPGM(" pTerm ");
-      SERIAL_ECHO(pTerm_bed);
-      SERIAL_ECHOPGM(" iTerm ");
-      SERIAL_ECHO(iTerm_bed);
-      SERIAL_ECHOPGM(" dTerm ");
-      SERIAL_ECHOLN(dTerm_bed);
+      #if ENABLED(PID_FIXED_POINT)
+        SERIAL_ECHOPGM(" pTerm ");
+        SERIAL_ECHO(FIXED_TO_FLOAT(pid_fixed_bed.pTerm));
+        SERIAL_ECHOPGM(" iTerm ");
+        SERIAL_ECHO(FIXED_TO_FLOAT(fixmul(pid_fixed_bed.Ki, pid_fixed_bed.iState)));
+        SERIAL_ECHOPGM(" dTerm ");
+        SERIAL_ECHOLN(FIXED_TO_FLOAT(pid_fixed_bed.dTerm));
+      #else
+        SERIAL_ECHOPGM(" pTerm ");
+        SERIAL_ECHO(pTerm_bed);
+        SERIAL_ECHOPGM(" iTerm ");
+        SERIAL_ECHO(iTerm_bed);
+        SERIAL_ECHOPGM(" dTerm ");
+        SERIAL_ECHOLN(dTerm_bed);
+      #endif
     #endif // PID_BED_DEBUG
 
     return pid_output;
@@ -784,6 +925,8 @@ float Temperature::get_pid_output(const int8_t e) {
  */
 void Temperature::manage_heater() {
 
+  PROFILE_SCOPE(MANAGE_HEATER);
+
   #if ENABLED(PROBING_HEATERS_OFF) && ENABLED(BED_LIMIT_SWITCHING)
     static bool last_pause_state;
   #endif
@@ -964,6 +1107,26 @@ void Temperature::manage_heater() {
   }                                                                    \
 }while(0)
 
+#if defined(HEATER_0_DIRECT_TABLE) || defined(BED_DIRECT_TABLE)
+
+  /**
+   * Look up 'raw' in a direct table with one entry per ADC count, in 1/16 °C.
+   * The oversampling bits interpolate between two entries in integer math.
+   */
+  static int16_t direct_temp16(const int16_t * const tbl, const int16_t adc_min, const int16_t adc_max, const int16_t out, const int raw) {
+    if (raw < OV(adc_min) || raw > OV(adc_max)) return out * 16;
+    const uint16_t r = raw - OV(adc_min);
+    const int16_t * const p = &tbl[r / (OVERSAMPLENR)];
+    const int16_t t0 = pgm_read_word(p);
+    const uint8_t frac = r % (OVERSAMPLENR);
+    return frac ? t0 + int16_t(int32_t(int16_t(pgm_read_word(p + 1)) - t0) * frac / (OVERSAMPLENR)) : t0;
+  }
+
+  #define _DIRECT_TEMP16(N,RAW) direct_temp16(temptable_direct_##N, TEMPTABLE_DIRECT_##N##_MIN, TEMPTABLE_DIRECT_##N##_MAX, TEMPTABLE_DIRECT_##N##_OUT, RAW)
+  #define DIRECT_TEMP16(N,RAW) _DIRECT_TEMP16(N,RAW)
+
+#endif
+
 // Derived from RepRap FiveD extruder::getTemperature()
 // For hot end temperature measurement.
 float Temperature::analog2temp(const int raw, const uint8_t e) {
@@ -991,6 +1154,8 @@ float Temperature::analog2temp(const int raw, const uint8_t e) {
         return TEMP_AD595(raw);
       #elif ENABLED(HEATER_0_USES_AD8495)
         return TEMP_AD8495(raw);
+      #elif defined(HEATER_0_DIRECT_TABLE)
+        return DIRECT_TEMP16(HEATER_0_DIRECT_TABLE, raw) * (1.0f / 16);
       #else
         break;
       #endif
@@ -1042,7 +1207,9 @@ float Temperature::analog2temp(const int raw, const uint8_t e) {
   // Derived from RepRap FiveD extruder::getTemperature()
   // For bed temperature measurement.
   float Temperature::analog2tempBed(const int raw) {
-    #if ENABLED(HEATER_BED_USES_THERMISTOR)
+    #if defined(BED_DIRECT_TABLE)
+      return DIRECT_TEMP16(BED_DIRECT_TABLE, raw) * (1.0f / 16);
+    #elif ENABLED(HEATER_BED_USES_THERMISTOR)
       SCAN_THERMISTOR_TABLE(BEDTEMPTABLE, BEDTEMPTABLE_LEN);
     #elif ENABLED(HEATER_BED_USES_AD595)
       return TEMP_AD595(raw);
@@ -1321,11 +1488,30 @@ void Temperature::init() {
         maxttemp_raw[NR] += OVERSAMPLENR; \
     }
 
+  // Direct tables are thermistors, so hotter is a lower raw value.
+  // Compare in 1/16 °C, the same domain as the table.
+  #define DIRECT_MIN_ROUTINE(NR,TBL) \
+    minttemp[NR] = HEATER_ ##NR## _MINTEMP; \
+    while (DIRECT_TEMP16(TBL, minttemp_raw[NR]) < (HEATER_ ##NR## _MINTEMP) * 16) \
+      minttemp_raw[NR] -= OVERSAMPLENR;
+  #define DIRECT_MAX_ROUTINE(NR,TBL) \
+    maxttemp[NR] = HEATER_ ##NR## _MAXTEMP; \
+    while (DIRECT_TEMP16(TBL, maxttemp_raw[NR]) > (HEATER_ ##NR## _MAXTEMP) * 16) \
+      maxttemp_raw[NR] += OVERSAMPLENR;
+
   #ifdef HEATER_0_MINTEMP
-    TEMP_MIN_ROUTINE(0);
+    #ifdef HEATER_0_DIRECT_TABLE
+      DIRECT_MIN_ROUTINE(0, HEATER_0_DIRECT_TABLE);
+    #else
+      TEMP_MIN_ROUTINE(0);
+    #endif
   #endif
   #ifdef HEATER_0_MAXTEMP
-    TEMP_MAX_ROUTINE(0);
+    #ifdef HEATER_0_DIRECT_TABLE
+      DIRECT_MAX_ROUTINE(0, HEATER_0_DIRECT_TABLE);
+    #else
+      TEMP_MAX_ROUTINE(0);
+    #endif
   #endif
   #if HOTENDS > 1
     #ifdef HEATER_1_MINTEMP
@@ -1361,7 +1547,10 @@ void Temperature::init() {
   #endif // HOTENDS > 1
 
   #if HAS_HEATED_BED
-    #ifdef BED_MINTEMP
+    #if defined(BED_MINTEMP) && defined(BED_DIRECT_TABLE)
+      while (DIRECT_TEMP16(BED_DIRECT_TABLE, bed_minttemp_raw) < (BED_MINTEMP) * 16)
+        bed_minttemp_raw -= OVERSAMPLENR;
+    #elif defined(BED_MINTEMP)
       while (analog2tempBed(bed_minttemp_raw) < BED_MINTEMP) {
         #if HEATER_BED_RAW_LO_TEMP < HEATER_BED_RAW_HI_TEMP
           bed_minttemp_raw += OVERSAMPLENR;
@@ -1370,7 +1559,10 @@ void Temperature::init() {
         #endif
       }
     #endif // BED_MINTEMP
-    #ifdef BED_MAXTEMP
+    #if defined(BED_MAXTEMP) && defined(BED_DIRECT_TABLE)
+      while (DIRECT_TEMP16(BED_DIRECT_TABLE, bed_maxttemp_raw) > (BED_MAXTEMP) * 16)
+        bed_maxttemp_raw += OVERSAMPLENR;
+    #elif defined(BED_MAXTEMP)
       while (analog2tempBed(bed_maxttemp_raw) > BED_MAXTEMP) {
         #if HEATER_BED_RAW_LO_TEMP < HEATER_BED_RAW_HI_TEMP
           bed_maxttemp_raw -= OVERSAMPLENR;
@@ -1902,6 +2094,8 @@ void Temperature::readings_ready() {
 HAL_TEMP_TIMER_ISR {
   HAL_timer_isr_prologue(TEMP_TIMER_NUM);
 
+  PROFILE_SCOPE(TEMPERATURE_ISR);
+
   Temperature::isr();
 
   HAL_timer_isr_epilogue(TEMP_TIMER_NUM);
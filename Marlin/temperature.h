@@ -124,6 +124,22 @@ enum ADCSensorState : char {
   #define unscalePID_d(d) ( (d) * float(PID_dT) )
 #endif
 
+#if ENABLED(PID_FIXED_POINT)
+  // Q16.16 fixed point
+  typedef int32_t fixed_t;
+  #define FIXED(F)          fixed_t((F) * 65536.0f)
+  #define FIXED_INT(I)      (fixed_t(I) << 16)
+  #define FIXED_TO_FLOAT(X) (float(X) * (1.0f / 65536.0f))
+
+  typedef struct {
+    fixed_t Kp, Ki, Kd,   // Ki and Kd are scaled by PID_dT, like the float gains
+            error_max,    // Limits that keep Kp * error, Ki * iState
+            iState_max,   //  and Kd * delta in range
+            delta_max,
+            iState, dState, pTerm, dTerm;
+  } pid_fixed_t;
+#endif
+
 class Temperature {
 
   public:
@@ -217,11 +233,16 @@ class Temperature {
     #endif
 
     #if ENABLED(PIDTEMP)
-      static float temp_iState[HOTENDS],
-                   temp_dState[HOTENDS],
-                   pTerm[HOTENDS],
-                   iTerm[HOTENDS],
-                   dTerm[HOTENDS];
+      #if ENABLED(PID_FIXED_POINT)
+        static pid_fixed_t pid_fixed[HOTENDS];
+      #else
+        static float temp_iState[HOTENDS],
+                     temp_dState[HOTENDS],
+                     pTerm[HOTENDS],
+                     iTerm[HOTENDS],
+                     dTerm[HOTENDS],
+                     pid_error[HOTENDS];
+      #endif
 
       #if ENABLED(PID_EXTRUSION_SCALING)
         static float cTerm[HOTENDS];
@@ -230,7 +251,6 @@ class Temperature {
         static int lpq_ptr;
       #endif
 
-      static float pid_error[HOTENDS];
       static bool pid_reset[HOTENDS];
     #endif
 
@@ -246,7 +266,9 @@ class Temperature {
         static uint16_t watch_target_bed_temp;
         static millis_t watch_bed_next_ms;
       #endif
-      #if ENABLED(PIDTEMPBED)
+      #if ENABLED(PIDTEMPBED) && ENABLED(PID_FIXED_POINT)
+        static pid_fixed_t pid_fixed_bed;
+      #elif ENABLED(PIDTEMPBED)
         static float temp_iState_bed,
                      temp_dState_bed,
                      pTerm_bed,
@@ -507,12 +529,8 @@ class Temperature {
       /**
        * Update the temp manager when PID values change
        */
-      #if ENABLED(PIDTEMP)
-        FORCE_INLINE static void updatePID() {
-          #if ENABLED(PID_EXTRUSION_SCALING)
-            last_e_position = 0;
-          #endif
-        }
+      #if ENABLED(PIDTEMP) || ENABLED(PIDTEMPBED)
+        static void updatePID();
       #endif
 
     #endif
@@ -0,0 +1,121 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Generated by buildroot/share/scripts/createDirectThermistorTable.py 1
+ * from thermistortable_1.h. Do not edit, run the script again instead.
+ *
+ * Temperature in 1/16 degC for each ADC count from TEMPTABLE_DIRECT_1_MIN
+ * to TEMPTABLE_DIRECT_1_MAX. Readings outside the table give TEMPTABLE_DIRECT_1_OUT,
+ * as SCAN_THERMISTOR_TABLE does.
+ */
+
+#define TEMPTABLE_DIRECT_1_MIN 23
+#define TEMPTABLE_DIRECT_1_MAX 1020
+#define TEMPTABLE_DIRECT_1_OUT (-15)
+
+const int16_t temptable_direct_1[] PROGMEM = {
+   4800,  4760,  4720,  4680,  4640,  4560,  4533,  4507,  4480,  4440,  4400,  4360, // ADC 23
+   4320,  4293,  4267,  4240,  4213,  4187,  4160,  4133,  4107,  4080,  4060,  4040, // ADC 35
+   4020,  4000,  3980,  3960,  3940,  3920,  3900,  3880,  3860,  3840,  3824,  3808, // ADC 47
+   3792,  3776,  3760,  3744,  3728,  3712,  3696,  3680,  3664,  3648,  3632,  3616, // ADC 59
+   3600,  3589,  3577,  3566,  3554,  3543,  3531,  3520,  3507,  3493,  3480,  3467, // ADC 71
+   3453,  3440,  3430,  3420,  3410,  3400,  3390,  3380,  3370,  3360,  3350,  3340, // ADC 83
+   3330,  3320,  3310,  3300,  3290,  3280,  3271,  3262,  3253,  3244,  3236,  3227, // ADC 95
+   3218,  3209,  3200,  3193,  3185,  3178,  3171,  3164,  3156,  3149,  3142,  3135, // ADC 107
+   3127,  3120,  3113,  3105,  3098,  3091,  3084,  3076,  3069,  3062,  3055,  3047, // ADC 119
+   3040,  3033,  3027,  3020,  3013,  3007,  3000,  2993,  2987,  2980,  2973,  2967, // ADC 131
+   2960,  2954,  2948,  2942,  2935,  2929,  2923,  2917,  2911,  2905,  2898,  2892, // ADC 143
+   2886,  2880,  2875,  2869,  2864,  2859,  2853,  2848,  2843,  2837,  2832,  2827, // ADC 155
+   2821,  2816,  2811,  2805,  2800,  2795,  2790,  2785,  2780,  2775,  2770,  2765, // ADC 167
+   2760,  2755,  2750,  2745,  2740,  2735,  2730,  2725,  2720,  2716,  2711,  2707, // ADC 179
+   2702,  2698,  2693,  2689,  2684,  2680,  2676,  2671,  2667,  2662,  2658,  2653, // ADC 191
+   2649,  2644,  2640,  2636,  2632,  2627,  2623,  2619,  2615,  2611,  2606,  2602, // ADC 203
+   2598,  2594,  2589,  2585,  2581,  2577,  2573,  2568,  2564,  2560,  2556,  2552, // ADC 215
+   2549,  2545,  2541,  2537,  2533,  2530,  2526,  2522,  2518,  2514,  2510,  2507, // ADC 227
+   2503,  2499,  2495,  2491,  2488,  2484,  2480,  2477,  2473,  2470,  2466,  2463, // ADC 239
+   2459,  2456,  2452,  2449,  2445,  2442,  2438,  2435,  2431,  2428,  2424,  2421, // ADC 251
+   2417,  2414,  2410,  2407,  2403,  2400,  2397,  2394,  2390,  2387,  2384,  2381, // ADC 263
+   2378,  2374,  2371,  2368,  2365,  2362,  2358,  2355,  2352,  2349,  2346,  2342, // ADC 275
+   2339,  2336,  2333,  2330,  2326,  2323,  2320,  2317,  2314,  2311,  2308,  2305, // ADC 287
+   2302,  2299,  2296,  2293,  2290,  2287,  2284,  2281,  2279,  2276,  2273,  2270, // ADC 299
+   2267,  2264,  2261,  2258,  2255,  2252,  2249,  2246,  2243,  2240,  2237,  2234, // ADC 311
+   2231,  2229,  2226,  2223,  2220,  2217,  2214,  2211,  2209,  2206,  2203,  2200, // ADC 323
+   2197,  2194,  2191,  2189,  2186,  2183,  2180,  2177,  2174,  2171,  2169,  2166, // ADC 335
+   2163,  2160,  2157,  2155,  2152,  2150,  2147,  2145,  2142,  2139,  2137,  2134, // ADC 347
+   2132,  2129,  2126,  2124,  2121,  2119,  2116,  2114,  2111,  2108,  2106,  2103, // ADC 359
+   2101,  2098,  2095,  2093,  2090,  2088,  2085,  2083,  2080,  2078,  2075,  2072, // ADC 371
+   2070,  2068,  2065,  2062,  2060,  2058,  2055,  2052,  2050,  2048,  2045,  2042, // ADC 383
+   2040,  2038,  2035,  2032,  2030,  2028,  2025,  2022,  2020,  2018,  2015,  2012, // ADC 395
+   2010,  2008,  2005,  2002,  2000,  1998,  1995,  1993,  1991,  1988,  1986,  1984, // ADC 407
+   1981,  1979,  1976,  1974,  1972,  1969,  1967,  1965,  1962,  1960,  1958,  1955, // ADC 419
+   1953,  1951,  1948,  1946,  1944,  1941,  1939,  1936,  1934,  1932,  1929,  1927, // ADC 431
+   1925,  1922,  1920,  1918,  1915,  1913,  1911,  1909,  1906,  1904,  1902,  1899, // ADC 443
+   1897,  1895,  1893,  1890,  1888,  1886,  1883,  1881,  1879,  1877,  1874,  1872, // ADC 455
+   1870,  1867,  1865,  1863,  1861,  1858,  1856,  1854,  1851,  1849,  1847,  1845, // ADC 467
+   1842,  1840,  1838,  1836,  1833,  1831,  1829,  1827,  1824,  1822,  1820,  1818, // ADC 479
+   1816,  1813,  1811,  1809,  1807,  1804,  1802,  1800,  1798,  1796,  1793,  1791, // ADC 491
+   1789,  1787,  1784,  1782,  1780,  1778,  1776,  1773,  1771,  1769,  1767,  1764, // ADC 503
+   1762,  1760,  1758,  1756,  1754,  1751,  1749,  1747,  1745,  1743,  1741,  1738, // ADC 515
+   1736,  1734,  1732,  1730,  1728,  1725,  1723,  1721,  1719,  1717,  1715,  1712, // ADC 527
+   1710,  1708,  1706,  1704,  1702,  1699,  1697,  1695,  1693,  1691,  1689,  1686, // ADC 539
+   1684,  1682,  1680,  1678,  1676,  1674,  1672,  1669,  1667,  1665,  1663,  1661, // ADC 551
+   1659,  1657,  1655,  1653,  1651,  1648,  1646,  1644,  1642,  1640,  1638,  1636, // ADC 563
+   1634,  1632,  1629,  1627,  1625,  1623,  1621,  1619,  1617,  1615,  1613,  1611, // ADC 575
+   1608,  1606,  1604,  1602,  1600,  1598,  1596,  1594,  1591,  1589,  1587,  1585, // ADC 587
+   1583,  1581,  1578,  1576,  1574,  1572,  1570,  1568,  1565,  1563,  1561,  1559, // ADC 599
+   1557,  1555,  1552,  1550,  1548,  1546,  1544,  1542,  1539,  1537,  1535,  1533, // ADC 611
+   1531,  1529,  1526,  1524,  1522,  1520,  1518,  1516,  1514,  1511,  1509,  1507, // ADC 623
+   1505,  1503,  1501,  1498,  1496,  1494,  1492,  1490,  1488,  1485,  1483,  1481, // ADC 635
+   1479,  1477,  1475,  1472,  1470,  1468,  1466,  1464,  1462,  1459,  1457,  1455, // ADC 647
+   1453,  1451,  1449,  1446,  1444,  1442,  1440,  1438,  1436,  1434,  1431,  1429, // ADC 659
+   1427,  1425,  1423,  1421,  1418,  1416,  1414,  1412,  1410,  1408,  1405,  1403, // ADC 671
+   1401,  1399,  1397,  1395,  1392,  1390,  1388,  1386,  1384,  1382,  1379,  1377, // ADC 683
+   1375,  1373,  1371,  1369,  1366,  1364,  1362,  1360,  1358,  1355,  1353,  1351, // ADC 695
+   1349,  1346,  1344,  1342,  1339,  1337,  1335,  1333,  1330,  1328,  1326,  1323, // ADC 707
+   1321,  1319,  1317,  1314,  1312,  1310,  1307,  1305,  1303,  1301,  1298,  1296, // ADC 719
+   1294,  1291,  1289,  1287,  1285,  1282,  1280,  1278,  1275,  1273,  1270,  1268, // ADC 731
+   1265,  1263,  1261,  1258,  1256,  1253,  1251,  1248,  1246,  1244,  1241,  1239, // ADC 743
+   1236,  1234,  1232,  1229,  1227,  1224,  1222,  1219,  1217,  1215,  1212,  1210, // ADC 755
+   1207,  1205,  1202,  1200,  1197,  1195,  1192,  1190,  1187,  1185,  1182,  1179, // ADC 767
+   1177,  1174,  1172,  1169,  1166,  1164,  1161,  1159,  1156,  1154,  1151,  1148, // ADC 779
+   1146,  1143,  1141,  1138,  1135,  1133,  1130,  1128,  1125,  1123,  1120,  1117, // ADC 791
+   1114,  1112,  1109,  1106,  1103,  1101,  1098,  1095,  1092,  1090,  1087,  1084, // ADC 803
+   1081,  1079,  1076,  1073,  1070,  1068,  1065,  1062,  1059,  1057,  1054,  1051, // ADC 815
+   1048,  1046,  1043,  1040,  1037,  1034,  1031,  1028,  1025,  1022,  1019,  1016, // ADC 827
+   1013,  1010,  1007,  1004,  1001,   999,   996,   993,   990,   987,   984,   981, // ADC 839
+    978,   975,   972,   969,   966,   963,   960,   957,   953,   950,   947,   943, // ADC 851
+    940,   937,   933,   930,   927,   923,   920,   917,   913,   910,   907,   903, // ADC 863
+    900,   897,   893,   890,   887,   883,   880,   876,   873,   869,   865,   862, // ADC 875
+    858,   855,   851,   847,   844,   840,   836,   833,   829,   825,   822,   818, // ADC 887
+    815,   811,   807,   804,   800,   796,   792,   787,   783,   779,   775,   771, // ADC 899
+    766,   762,   758,   754,   749,   745,   741,   737,   733,   728,   724,   720, // ADC 911
+    715,   711,   706,   701,   696,   692,   687,   682,   678,   673,   668,   664, // ADC 923
+    659,   654,   649,   645,   640,   635,   629,   624,   619,   613,   608,   603, // ADC 935
+    597,   592,   587,   581,   576,   571,   565,   560,   553,   547,   540,   533, // ADC 947
+    527,   520,   513,   507,   500,   493,   487,   480,   473,   465,   458,   451, // ADC 959
+    444,   436,   429,   422,   415,   407,   400,   390,   380,   370,   360,   350, // ADC 971
+    340,   330,   320,   310,   300,   290,   280,   270,   260,   250,   240,   227, // ADC 983
+    213,   200,   187,   173,   160,   144,   128,   112,    96,    80,    60,    40, // ADC 995
+     20,     0,   -20,   -40,   -60,   -80,  -100,  -120,  -140,  -160,  -180,  -200, // ADC 1007
+   -220,  -240  // ADC 1019
+};
@@ -43,6 +43,7 @@
 
 #if ANY_THERMISTOR_IS(1) // 100k bed thermistor
   #include "thermistortable_1.h"
+  #include "thermistortable_direct_1.h"
 #endif
 #if ANY_THERMISTOR_IS(2) // 200k bed thermistor
   #include "thermistortable_2.h"
@@ -203,6 +204,15 @@
   #define CHAMBERTEMPTABLE_LEN 0
 #endif
 
+// Sensors with a direct table (one entry per ADC count, generated by
+// buildroot/share/scripts/createDirectThermistorTable.py) skip the table scan
+#if THERMISTORHEATER_0 == 1
+  #define HEATER_0_DIRECT_TABLE 1
+#endif
+#if THERMISTORBED == 1
+  #define BED_DIRECT_TABLE 1
+#endif
+
 // The SCAN_THERMISTOR_TABLE macro needs alteration?
 static_assert(HEATER_0_TEMPTABLE_LEN < 256 && HEATER_1_TEMPTABLE_LEN < 256 && HEATER_2_TEMPTABLE_LEN < 256 && HEATER_3_TEMPTABLE_LEN < 256 && HEATER_4_TEMPTABLE_LEN < 256 && BEDTEMPTABLE_LEN < 256 && CHAMBERTEMPTABLE_LEN < 256,
   "Temperature conversion tables over 255 entries need special consideration."
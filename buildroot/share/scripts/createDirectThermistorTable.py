@@ -0,0 +1,176 @@
+#!/usr/bin/python
+"""Direct Thermistor Table Generator
+
+Generates a uniformly indexed thermistor table from one of Marlin's
+thermistortable_N.h files: one entry per ADC count, in 1/16 degC, so the
+firmware converts a reading with a single table read and an integer
+interpolation over the oversampling bits instead of a bisect search and a
+float divide.
+
+The entries are the exact values of Marlin's SCAN_THERMISTOR_TABLE at each
+ADC count, so the direct lookup follows the same piecewise-linear curve.
+
+Usage: python createDirectThermistorTable.py [options] N
+
+Options:
+  -h, --help        show this help
+  --marlin=...      path to the Marlin folder (default: ../../../Marlin)
+  --check           don't generate. Compare the direct table in the Marlin
+                    folder against the source table over the full raw range
+                    and exit with an error if they differ by over 1/8 degC.
+"""
+
+from __future__ import print_function
+import os
+import re
+import sys
+import getopt
+
+OVERSAMPLENR = 16
+RAW_MAX      = 16383                        # 1023 * OVERSAMPLENR plus spare bits
+MAX_ERROR    = 0.125                        # degC allowed by --check
+
+LICENSE = """/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+"""
+
+def read_source_table(marlin, n):
+    "Read the { OV(adc), temp } pairs of thermistortable_N.h"
+    with open(os.path.join(marlin, "thermistortable_%s.h" % n)) as f:
+        text = f.read()
+    body = text[text.index("temptable_%s[][2]" % n):]
+    body = body[:body.index("};")]
+    rows = re.findall(r"\{\s*OV\(\s*(-?\d+)\s*\)\s*,\s*(-?\d+)\s*\}", body)
+    if not rows:
+        sys.exit("No OV() entries found in thermistortable_%s.h" % n)
+    return [(int(adc) * OVERSAMPLENR, int(temp)) for adc, temp in rows]
+
+def scan_table(table, raw):
+    "Python copy of SCAN_THERMISTOR_TABLE in temperature.cpp"
+    l, r = 0, len(table)
+    while True:
+        m = (l + r) >> 1
+        if m == l or m == r:
+            return float(table[-1][1])
+        v00, v10 = table[m - 1][0], table[m][0]
+        if raw < v00:
+            r = m
+        elif raw > v10:
+            l = m
+        else:
+            v01, v11 = table[m - 1][1], table[m][1]
+            return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00)
+
+def direct_table(table):
+    "Temperature in 1/16 degC for each ADC count covered by the table"
+    lo, hi = table[0][0] // OVERSAMPLENR, table[-1][0] // OVERSAMPLENR
+    return lo, hi, [int(round(scan_table(table, adc * OVERSAMPLENR) * 16)) for adc in range(lo, hi + 1)]
+
+def direct_lookup(lo, hi, out, values, raw):
+    "Python copy of the direct lookup in temperature.cpp, in 1/16 degC"
+    if raw < lo * OVERSAMPLENR or raw > hi * OVERSAMPLENR:
+        return out * 16
+    r = raw - lo * OVERSAMPLENR
+    i, frac = r // OVERSAMPLENR, r % OVERSAMPLENR
+    t0 = values[i]
+    if not frac:
+        return t0
+    d = (values[i + 1] - t0) * frac
+    return t0 + int(float(d) / OVERSAMPLENR)  # C truncates toward zero
+
+def read_direct_table(marlin, n):
+    "Read back a generated thermistortable_direct_N.h"
+    with open(os.path.join(marlin, "thermistortable_direct_%s.h" % n)) as f:
+        text = f.read()
+    define = lambda name: int(re.search(r"#define TEMPTABLE_DIRECT_%s_%s\s+\(?(-?\d+)" % (n, name), text).group(1))
+    body = text[text.index("temptable_direct_%s[]" % n):]
+    body = re.sub(r"//.*", "", body[body.index("{") + 1:body.index("};")])
+    values = [int(v) for v in re.findall(r"-?\d+", body)]
+    return define("MIN"), define("MAX"), define("OUT"), values
+
+def generate(marlin, n):
+    table = read_source_table(marlin, n)
+    lo, hi, values = direct_table(table)
+    lines = [LICENSE]
+    lines.append("/**")
+    lines.append(" * Generated by buildroot/share/scripts/createDirectThermistorTable.py %s" % n)
+    lines.append(" * from thermistortable_%s.h. Do not edit, run the script again instead." % n)
+    lines.append(" *")
+    lines.append(" * Temperature in 1/16 degC for each ADC count from TEMPTABLE_DIRECT_%s_MIN" % n)
+    lines.append(" * to TEMPTABLE_DIRECT_%s_MAX. Readings outside the table give TEMPTABLE_DIRECT_%s_OUT," % (n, n))
+    lines.append(" * as SCAN_THERMISTOR_TABLE does.")
+    lines.append(" */")
+    lines.append("")
+    lines.append("#define TEMPTABLE_DIRECT_%s_MIN %d" % (n, lo))
+    lines.append("#define TEMPTABLE_DIRECT_%s_MAX %d" % (n, hi))
+    lines.append("#define TEMPTABLE_DIRECT_%s_OUT (%d)" % (n, table[-1][1]))
+    lines.append("")
+    lines.append("const int16_t temptable_direct_%s[] PROGMEM = {" % n)
+    for i in range(0, len(values), 12):
+        row = ", ".join("%5d" % v for v in values[i:i + 12])
+        lines.append("  %s%s // ADC %d" % (row, "," if i + 12 < len(values) else " ", lo + i))
+    lines.append("};")
+    with open(os.path.join(marlin, "thermistortable_direct_%s.h" % n), "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+def check(marlin, n):
+    table = read_source_table(marlin, n)
+    lo, hi, out, values = read_direct_table(marlin, n)
+    if values != direct_table(table)[2]:
+        print("thermistortable_direct_%s.h is stale, run the script again" % n)
+        return 1
+    worst, worst_raw = 0.0, 0
+    for raw in range(RAW_MAX + 1):
+        err = abs(direct_lookup(lo, hi, out, values, raw) / 16.0 - scan_table(table, raw))
+        if err > worst:
+            worst, worst_raw = err, raw
+    print("table %s: max error %.4f degC at raw %d" % (n, worst, worst_raw))
+    return 1 if worst > MAX_ERROR else 0
+
+def usage():
+    print(__doc__)
+
+def main(argv):
+    marlin = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "..", "Marlin")
+    do_check = False
+    try:
+        opts, args = getopt.getopt(argv, "h", ["help", "marlin=", "check"])
+    except getopt.GetoptError:
+        usage()
+        sys.exit(2)
+    for opt, arg in opts:
+        if opt in ("-h", "--help"):
+            usage()
+            sys.exit()
+        elif opt == "--marlin":
+            marlin = arg
+        elif opt == "--check":
+            do_check = True
+    if len(args) != 1:
+        usage()
+        sys.exit(2)
+    if do_check:
+        sys.exit(check(marlin, args[0]))
+    generate(marlin, args[0])
+
+if __name__ == "__main__":
+    main(sys.argv[1:])